@@ -0,0 +1,599 @@
+/* Micro-benchmarks for carp. Prints one CSV row per benchmark:
+ *
+ *     benchmark,params,iterations,ns_per_op,ops_per_s
+ *
+ * Each figure is the best of several timed samples, so runs can be diffed
+ * across releases. Usage: carp_bench [-f filter] [-t min_ms_per_sample] */
+#include <carp.h>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::literals::string_view_literals;
+
+namespace {
+
+template <typename T>
+inline void keep(T const &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static void const *volatile sink;
+    sink = &value;
+#endif
+}
+
+struct harness {
+    std::string_view filter;
+    double min_sample_ns = 20e6;
+    static constexpr int n_samples = 5;
+
+    template <typename F>
+    void run(std::string_view name, std::string const &params, F &&op) const {
+        if (!filter.empty() && name.find(filter) == std::string_view::npos)
+            return;
+
+        using clock = std::chrono::steady_clock;
+        auto time = [&](size_t iterations) {
+            auto start = clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+                op(i);
+            return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        };
+
+        size_t iterations = 1;
+        while (time(iterations) < min_sample_ns / 8)
+            iterations *= 2;
+        iterations *= 8;
+
+        double best = time(iterations);
+        for (int s = 1; s < n_samples; ++s)
+            best = std::min(best, time(iterations));
+
+        double const ns_per_op = best / iterations;
+        std::printf("%.*s,%s,%zu,%.3f,%.0f\n", static_cast<int>(name.size()), name.data(),
+                    params.c_str(), iterations, ns_per_op, 1e9 / ns_per_op);
+        std::fflush(stdout);
+    }
+};
+
+/* N generated switch names, "--o00000" to "--oNNNNN". */
+template <size_t N>
+struct generated_names {
+    static constexpr size_t width = 8;
+    char text[N * width] = {};
+
+    constexpr generated_names() {
+        for (size_t i = 0; i < N; ++i) {
+            auto *p = text + i * width;
+            p[0] = p[1] = '-';
+            p[2] = 'o';
+            for (size_t d = width, v = i; d-- > 3; v /= 10)
+                p[d] = static_cast<char>('0' + v % 10);
+        }
+    }
+
+    constexpr std::string_view operator[](size_t i) const { return {text + i * width, width}; }
+};
+
+template <size_t N>
+inline constexpr generated_names<N> names{};
+
+/* every fourth switch takes a value, and each can be set by the environment
+ * variable of its name without dashes. */
+template <size_t N>
+struct generated_table {
+    typename carp::parser<N>::arg args[N];
+
+    constexpr generated_table() {
+        for (size_t i = 0; i < N; ++i)
+            args[i] = {names<N>[i], "a generated switch, documented by a sentence long enough "
+                                    "to be wrapped over a couple of lines by usage()",
+                       i % 4 == 0 ? 1u : 0u, names<N>[i].substr(2)};
+    }
+};
+
+template <size_t N>
+inline constexpr generated_table<N> table{};
+
+template <size_t N>
+inline constexpr auto generated_parser = carp::parser<N>(table<N>.args);
+
+/* a deterministic command line of argc words drawn from the N switches. */
+struct command_line {
+    std::vector<std::string> words;
+    std::vector<char const *> argv;
+
+    int argc() const { return static_cast<int>(argv.size()); }
+};
+
+template <size_t N>
+command_line make_command_line(size_t argc, uint32_t seed = 12345) {
+    command_line cl;
+    cl.words.push_back("program");
+
+    uint32_t state = seed;
+    while (cl.words.size() < argc) {
+        state = state * 1664525u + 1013904223u;
+        size_t const i = (state >> 8) % N;
+        cl.words.emplace_back(names<N>[i]);
+        if (i % 4 == 0)
+            cl.words.push_back(std::to_string(state % 1000));
+    }
+
+    for (auto &w : cl.words)
+        cl.argv.push_back(w.c_str());
+    return cl;
+}
+
+template <size_t N>
+void bench_parse(harness const &h, size_t argc) {
+    auto cl = make_command_line<N>(argc);
+    h.run("parse", "N=" + std::to_string(N) + " argc=" + std::to_string(cl.argc()),
+          [&](size_t) {
+              auto args = generated_parser<N>.parse(cl.argc(), cl.argv.data());
+              keep(args);
+          });
+}
+
+/* N positionals, "f00000" to "fNNNNN", and a "-v" switch. */
+template <size_t N>
+struct positional_table {
+    char text[N * 8] = {};
+    typename carp::parser<N + 1>::arg args[N + 1];
+
+    constexpr positional_table() {
+        for (size_t i = 0; i < N; ++i) {
+            auto *p = text + i * 8;
+            p[0] = 'f';
+            for (size_t d = 6, v = i; d-- > 1; v /= 10)
+                p[d] = static_cast<char>('0' + v % 10);
+            args[i] = {std::string_view(p, 6), "a generated positional"};
+        }
+        args[N] = {"-v", "a boolean switch"};
+    }
+};
+
+/* xargs style: one path per positional, with a -v among every 64 of them. */
+template <size_t N>
+void bench_paths(harness const &h) {
+    static positional_table<N> const positionals;
+    static auto const parser = carp::parser<N + 1>(positionals.args);
+
+    /* packed one after the other, as the kernel lays out argv */
+    std::string text = std::string("program") + '\0';
+    for (size_t i = 0; i < N; ++i) {
+        if (i % 64 == 32)
+            text += std::string("-v") + '\0';
+        text += "/home/user/src/project/module/file_" + std::to_string(i) + ".cc" + '\0';
+    }
+    std::vector<char const *> argv;
+    for (size_t i = 0; i < text.size(); i += std::strlen(text.data() + i) + 1)
+        argv.push_back(text.data() + i);
+    auto const argc = static_cast<int>(argv.size());
+
+    h.run("parse_paths", "N=" + std::to_string(N) + " argc=" + std::to_string(argc),
+          [&](size_t) {
+              auto args = parser.parse(argc, argv.data());
+              keep(args);
+          });
+}
+
+/* the same command line as a single string, split into a token_buffer. */
+template <size_t N>
+void bench_parse_cmdline(harness const &h, size_t argc) {
+    auto cl = make_command_line<N>(argc);
+    std::string cmdline;
+    for (auto &w : cl.words)
+        cmdline += w + ' ';
+
+    auto tokens = std::make_unique<carp::token_buffer<4096>>();
+    h.run("parse_cmdline", "N=" + std::to_string(N) + " argc=" + std::to_string(cl.argc()),
+          [&](size_t) {
+              auto args = generated_parser<N>.parse(cmdline, *tokens);
+              keep(args);
+          });
+}
+
+/* an @file of entries switches with values, mapped and split on every parse. */
+template <size_t N>
+void bench_response_file(harness const &h, size_t entries) {
+    auto const path =
+        (std::filesystem::temp_directory_path() / "carp_bench_response").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        auto cl = make_command_line<N>(entries);
+        for (size_t i = 1; i < cl.words.size(); ++i)
+            file << cl.words[i] << (i % 8 ? ' ' : '\n');
+    }
+
+    auto const word = "@" + path;
+    char const *const argv[] = {"program", word.c_str()};
+    auto arena = std::make_unique<carp::response_arena<(1 << 20), 4096, 1>>();
+    h.run("parse_response_file", "N=" + std::to_string(N) + " words=" + std::to_string(entries),
+          [&](size_t) {
+              auto args = generated_parser<N>.parse(2, argv, *arena);
+              keep(args);
+          });
+    std::remove(path.c_str());
+}
+
+/* a config file setting each of the N switches once, mapped and tokenised on
+ * every parse. */
+template <size_t N>
+void bench_config_file(harness const &h) {
+    auto const path =
+        (std::filesystem::temp_directory_path() / "carp_bench_config").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "# generated settings\n";
+        for (size_t i = 0; i < N; ++i)
+            file << names<N>[i].substr(2) << (i % 4 == 0 ? " = 42\n" : "\n");
+    }
+
+    char const *const argv[] = {"program"};
+    auto config = std::make_unique<carp::config_file<N>>();
+    h.run("parse_config_file", "N=" + std::to_string(N), [&](size_t) {
+        config->open(path);
+        auto args = generated_parser<N>.parse(1, argv, *config);
+        keep(args);
+    });
+    std::remove(path.c_str());
+}
+
+/* rows command lines at a time, one parsed_args each or into a single batch. */
+template <size_t N>
+void bench_batch(harness const &h, size_t argc, size_t rows) {
+    std::vector<command_line> cls;
+    std::vector<std::pair<int, char const *const *>> lines;
+    for (size_t r = 0; r < rows; ++r)
+        cls.push_back(make_command_line<N>(argc, static_cast<uint32_t>(r + 1)));
+    for (auto &cl : cls)
+        lines.emplace_back(cl.argc(), cl.argv.data());
+
+    auto const params = "N=" + std::to_string(N) + " argc=" + std::to_string(argc) +
+                        " rows=" + std::to_string(rows);
+
+    h.run("parse_rows", params, [&](size_t) {
+        for (auto [argc, argv] : lines) {
+            auto args = generated_parser<N>.parse(argc, argv);
+            keep(args);
+        }
+    });
+
+    using batch_type = typename carp::parser<N>::parsed_batch;
+    std::vector<uint64_t> present(rows * batch_type::words);
+    std::vector<uint32_t> offsets(rows * N), counts(rows * N);
+    std::unique_ptr<bool[]> ok(new bool[rows]);
+    batch_type batch{present.data(), offsets.data(), counts.data(), ok.get(), rows};
+
+    h.run("parse_batch", params, [&](size_t) {
+        auto n = generated_parser<N>.parse_batch(lines, batch);
+        keep(n);
+        keep(present);
+    });
+}
+
+/* an environment setting every other switch among unrelated variables, read in
+ * one pass or with a scan per switch. */
+template <size_t N>
+void bench_env(harness const &h) {
+    std::vector<std::string> entries;
+    for (size_t i = 0; i < 64; ++i)
+        entries.push_back("UNRELATED_" + std::to_string(i) + "=/usr/local/bin:/usr/bin");
+    for (size_t i = 0; i < N; i += 2)
+        entries.push_back(std::string(names<N>[i].substr(2)) + "=" + std::to_string(i));
+
+    std::vector<char const *> envp;
+    for (auto &e : entries)
+        envp.push_back(e.c_str());
+    envp.push_back(nullptr);
+
+    char const *const argv[] = {"program"};
+    auto const params =
+        "N=" + std::to_string(N) + " entries=" + std::to_string(entries.size());
+    h.run("parse_env", params, [&](size_t) {
+        auto args = generated_parser<N>.parse(1, argv, envp.data());
+        keep(args);
+    });
+
+    h.run("env_scans", params, [&](size_t) {
+        auto args = generated_parser<N>.parse(1, argv);
+        for (size_t i = 0; i < N; ++i) {
+            auto const name = names<N>[i].substr(2);
+            for (auto e = envp.data(); *e; ++e) {
+                if (std::strncmp(*e, name.data(), name.size()) || (*e)[name.size()] != '=')
+                    continue;
+                auto value = *e + name.size() + 1;
+                keep(value);
+                break;
+            }
+        }
+        keep(args);
+    });
+}
+
+/* the 16 switches of generated_parser<64> that take a value, as struct members. */
+struct sixteen {
+    int f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15;
+};
+
+template <size_t... I>
+constexpr auto bind_sixteen(std::index_sequence<I...>) {
+    constexpr int sixteen::*members[] = {
+        &sixteen::f0,  &sixteen::f1,  &sixteen::f2,  &sixteen::f3,
+        &sixteen::f4,  &sixteen::f5,  &sixteen::f6,  &sixteen::f7,
+        &sixteen::f8,  &sixteen::f9,  &sixteen::f10, &sixteen::f11,
+        &sixteen::f12, &sixteen::f13, &sixteen::f14, &sixteen::f15};
+    return generated_parser<64>.bind(carp::field<members[I]>(names<64>[I * 4])...);
+}
+
+inline constexpr auto sixteen_binder = bind_sixteen(std::make_index_sequence<16>{});
+
+/* every value switch of a command line into a struct, by name or bound. */
+void bench_bind(harness const &h, size_t argc) {
+    auto cl = make_command_line<64>(argc);
+    auto const params = "N=64 fields=16 argc=" + std::to_string(cl.argc());
+
+    h.run("parse_and_lookup", params, [&](size_t) {
+        auto args = generated_parser<64>.parse(cl.argc(), cl.argv.data());
+        sixteen out{};
+        int *fields[] = {&out.f0, &out.f1, &out.f2,  &out.f3,  &out.f4,  &out.f5,
+                         &out.f6, &out.f7, &out.f8,  &out.f9,  &out.f10, &out.f11,
+                         &out.f12, &out.f13, &out.f14, &out.f15};
+        for (size_t i = 0; i < 16; ++i)
+            *fields[i] = *(args[names<64>[i * 4]] | 0);
+        keep(out);
+    });
+
+    h.run("parse_into", params, [&](size_t) {
+        sixteen out{};
+        auto res = sixteen_binder.parse_into(cl.argc(), cl.argv.data(), out);
+        keep(out);
+        keep(res);
+    });
+}
+
+template <size_t N>
+void bench_lookup(harness const &h) {
+    auto cl = make_command_line<N>(64);
+    auto args = generated_parser<N>.parse(cl.argc(), cl.argv.data());
+
+    std::vector<std::string_view> keys;
+    for (size_t i = 0; i < N; ++i)
+        keys.push_back(names<N>[(i * 7919) % N]);
+
+    h.run("lookup_name", "N=" + std::to_string(N), [&](size_t i) {
+        auto proxy = args[keys[i % N]];
+        keep(proxy);
+    });
+
+    std::vector<typename carp::parser<N>::arg_id> ids;
+    for (auto k : keys)
+        ids.push_back(generated_parser<N>.id(k));
+
+    h.run("lookup_id", "N=" + std::to_string(N), [&](size_t i) {
+        auto proxy = args[ids[i % N]];
+        keep(proxy);
+    });
+
+    /* whether all of eight switches are given, one lookup each or as a mask */
+    auto const eight = [](size_t k) { return names<N>[k * N / 8]; };
+    h.run("flags_by_name", "N=" + std::to_string(N), [&](size_t) {
+        bool all = true;
+        for (size_t k = 0; k < 8; ++k)
+            all = all && args[eight(k)];
+        keep(all);
+    });
+
+    auto const mask = generated_parser<N>.mask(
+        {eight(0), eight(1), eight(2), eight(3), eight(4), eight(5), eight(6), eight(7)});
+    h.run("flags_by_mask", "N=" + std::to_string(N), [&](size_t) {
+        bool const all = args.present().all(mask);
+        keep(all);
+    });
+}
+
+template <typename T>
+void bench_unwrap(harness const &h, char const *type_name,
+                  std::vector<std::string> const &values) {
+    std::vector<char const *> argv;
+    for (auto &v : values)
+        argv.push_back(v.c_str());
+
+    h.run("unwrap", type_name, [&](size_t i) {
+        auto result = carp::unwrapper<T>::get(1, &argv[i % argv.size()]);
+        keep(result);
+    });
+
+    /* the standard library's own conversion, as a baseline for integers */
+    if constexpr (std::is_integral_v<T>) {
+        h.run("from_chars", type_name, [&](size_t i) {
+            auto const v = argv[i % argv.size()];
+            T result{};
+            std::from_chars(v, v + std::strlen(v), result);
+            keep(result);
+        });
+    }
+
+    /* the in-header parser used where from_chars lacks floating point, and strto* */
+    if constexpr (std::is_floating_point_v<T>) {
+        h.run("parse_float", type_name, [&](size_t i) {
+            auto const v = argv[i % argv.size()];
+            auto result = carp::detail::parse_float<T>(v, v + std::strlen(v));
+            keep(result);
+        });
+        h.run("strto*", type_name, [&](size_t i) {
+            auto const v = argv[i % argv.size()];
+            T result{};
+            if constexpr (std::is_same_v<T, float>)
+                result = std::strtof(v, nullptr);
+            else if constexpr (std::is_same_v<T, double>)
+                result = std::strtod(v, nullptr);
+            else
+                result = std::strtold(v, nullptr);
+            keep(result);
+        });
+    }
+}
+
+template <typename T>
+std::vector<std::string> integers() {
+    std::vector<std::string> values;
+    uint64_t state = 88172645463325252u;
+    for (int i = 0; i < 256; ++i) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        auto const digits = 1 + state % std::numeric_limits<T>::digits10;
+        uint64_t v = (state >> 8) % 10;
+        for (size_t d = 1; d < digits; ++d)
+            v = v * 10 + (state >> (8 + d)) % 10;
+        bool const negative = std::is_signed_v<T> && (state & 1);
+        values.push_back((negative ? "-" : "") + std::to_string(v));
+    }
+    return values;
+}
+
+template <typename T>
+std::vector<std::string> reals() {
+    std::vector<std::string> values;
+    uint64_t state = 88172645463325252u;
+    char buf[64];
+    for (int i = 0; i < 256; ++i) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        auto const v = static_cast<double>(state >> 11) * 0x1p-53 * 1e6;
+        std::snprintf(buf, sizeof buf, "%.*g", std::numeric_limits<T>::max_digits10, v);
+        values.push_back(buf);
+    }
+    return values;
+}
+
+void bench_unwrappers(harness const &h) {
+    bench_unwrap<signed char>(h, "signed char", integers<signed char>());
+    bench_unwrap<unsigned char>(h, "unsigned char", integers<unsigned char>());
+    bench_unwrap<char>(h, "char", integers<signed char>());
+    bench_unwrap<short>(h, "short", integers<short>());
+    bench_unwrap<unsigned short>(h, "unsigned short", integers<unsigned short>());
+    bench_unwrap<int>(h, "int", integers<int>());
+    bench_unwrap<unsigned>(h, "unsigned", integers<unsigned>());
+    bench_unwrap<long>(h, "long", integers<long>());
+    bench_unwrap<unsigned long>(h, "unsigned long", integers<unsigned long>());
+    bench_unwrap<long long>(h, "long long", integers<long long>());
+    bench_unwrap<unsigned long long>(h, "unsigned long long", integers<unsigned long long>());
+    bench_unwrap<float>(h, "float", reals<float>());
+    bench_unwrap<double>(h, "double", reals<double>());
+    bench_unwrap<long double>(h, "long double", reals<long double>());
+
+    char const *const array_argv[] = {"12", "-3", "456", "7890"};
+    h.run("unwrap", "std::array<int 4>", [&](size_t) {
+        auto result = carp::unwrapper<std::array<int, 4>>::get(4, array_argv);
+        keep(result);
+    });
+
+    char const *const tuple_argv[] = {"gasket", "42", "1.25"};
+    h.run("unwrap", "std::tuple<char const * int double>", [&](size_t) {
+        using T = std::tuple<char const *, int, double>;
+        auto result = carp::unwrapper<T>::get(3, tuple_argv);
+        keep(result);
+    });
+
+    std::string list;
+    for (int i = 0; i < 64; ++i)
+        list += (i ? "," : "") + std::to_string(i * 37);
+    char const *const list_argv[] = {list.c_str()};
+    h.run("unwrap", "carp::list<int 64>", [&](size_t) {
+        auto result = carp::unwrapper<carp::list<int, 64>>::get(1, list_argv);
+        keep(result);
+    });
+
+    char const *const cpus_argv[] = {"0-15,32-47,64-79,96-111,127"};
+    h.run("unwrap", "carp::list<unsigned 128> of ranges", [&](size_t) {
+        auto result = carp::unwrapper<carp::list<unsigned, 128>>::get(1, cpus_argv);
+        keep(result);
+    });
+}
+
+template <size_t N>
+void bench_usage(harness const &h) {
+    std::ostringstream os;
+    h.run("usage", "N=" + std::to_string(N), [&](size_t) {
+        os.str({});
+        os << generated_parser<N>.usage("program");
+        keep(os);
+    });
+    static char buf[1 << 16];
+    h.run("usage_to", "N=" + std::to_string(N), [&](size_t) {
+        keep(generated_parser<N>.usage_to(buf, sizeof buf, "program"));
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+
+    constexpr auto parser = carp::parser({
+        {"-f", "only run benchmarks whose name contains this string", 1},
+        {"-t", "minimum duration of each timed sample, in milliseconds", 1},
+        {"-h", "show this message"},
+    });
+
+    auto args = parser.parse(argc, argv);
+    auto filter = args["-f"] | ""sv;
+    auto min_ms = args["-t"] | 20.0;
+
+    if (!args.ok || args["-h"]) {
+        std::ostringstream os;
+        os << parser.usage(argv[0]) << "\n";
+        std::fputs(os.str().c_str(), stderr);
+        return !args.ok;
+    }
+
+    harness const h{*filter, *min_ms * 1e6};
+
+    std::puts("benchmark,params,iterations,ns_per_op,ops_per_s");
+
+    for (size_t n : {16, 256, 4096}) {
+        bench_parse<8>(h, n);
+        bench_parse<64>(h, n);
+        bench_parse<512>(h, n);
+        bench_parse_cmdline<64>(h, n);
+    }
+
+    bench_paths<1024>(h);
+    bench_paths<16384>(h);
+
+    for (size_t n : {1000, 10000, 100000, 1000000})
+        bench_response_file<64>(h, n);
+
+    bench_config_file<64>(h);
+    bench_config_file<512>(h);
+
+    bench_batch<8>(h, 16, 1024);
+    bench_batch<64>(h, 16, 1024);
+    bench_batch<512>(h, 16, 1024);
+
+    bench_env<8>(h);
+    bench_env<64>(h);
+    bench_env<512>(h);
+
+    bench_bind(h, 16);
+    bench_bind(h, 256);
+
+    bench_lookup<8>(h);
+    bench_lookup<64>(h);
+    bench_lookup<512>(h);
+
+    bench_unwrappers(h);
+
+    bench_usage<8>(h);
+    bench_usage<64>(h);
+    bench_usage<512>(h);
+
+    return 0;
+}
@@ -34,226 +34,3036 @@
 #include <cassert>
 #include <cctype>
 #include <cerrno>
+#include <cfloat>
 #include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <iosfwd>
 #include <iterator>
 #include <limits>
 #include <numeric>
 #include <optional>
+#include <ratio>
 #include <string_view>
 #include <system_error>
 #include <tuple>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#endif
+
+/* The POSIX headers declare open, write, stat and more in the global namespace,
+ * so they are opt-in: define CARP_POSIX before including carp.h for
+ * parser::write_usage, and for response and config files mapped with mmap
+ * rather than read with <cstdio>. */
+#if defined(CARP_POSIX) && __has_include(<unistd.h>)
+#define CARP_HAS_UNISTD 1
+#include <unistd.h>
+#else
+#define CARP_HAS_UNISTD 0
+#endif
+
+#if CARP_HAS_UNISTD && __has_include(<sys/mman.h>)
+#define CARP_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#define CARP_HAS_MMAP 0
+#endif
 
 namespace carp {
 
-namespace detail {
+namespace detail {
+
+/* true while evaluating a constant expression, where the library's runtime
+ * paths (from_chars, strto*, memcpy) are not allowed. */
+constexpr bool is_constant_evaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#else
+    return __builtin_is_constant_evaluated();
+#endif
+}
+
+constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+/* Bit i is set if words[i], one of n <= 64 C strings, starts with '-'. Only
+ * the leading bytes are read, with loads that do not depend on each other,
+ * where strlen would walk every word to its end. */
+constexpr uint64_t dash_mask(char const *const *words, size_t n) noexcept {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < n; ++i)
+        mask |= uint64_t{words[i][0] == '-'} << i;
+    return mask;
+}
+
+/* Integer decoding. Decimal digits are validated and accumulated eight at a
+ * time, SWAR style, in 64-bit words (and sixteen at a time with SSSE3).
+ * Hexadecimal, binary and octal numbers take a 0x, 0b or 0o prefix. */
+constexpr uint64_t ascii_zeros = 0x3030303030303030u;
+
+/* the eight characters at str as a little-endian word. */
+constexpr uint64_t load_digits(char const *str) noexcept {
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!is_constant_evaluated()) {
+        uint64_t x = 0;
+        std::memcpy(&x, str, 8);
+        return x;
+    }
+#endif
+    uint64_t x = 0;
+    for (size_t i = 0; i < 8; ++i)
+        x |= uint64_t{static_cast<unsigned char>(str[i])} << (8 * i);
+    return x;
+}
+
+constexpr bool all_digits(uint64_t x) noexcept {
+    constexpr uint64_t high_nibbles = 0xf0f0f0f0f0f0f0f0u;
+    return ((x & high_nibbles) | (((x + 0x0606060606060606u) & high_nibbles) >> 4)) ==
+           0x3333333333333333u;
+}
+
+constexpr uint32_t digits_value(uint64_t x) noexcept {
+    x -= ascii_zeros;
+    x = x * 10 + (x >> 8);
+    x = ((x & 0x000000ff000000ffu) * 0x000f424000000064u +
+         ((x >> 16) & 0x000000ff000000ffu) * 0x0000271000000001u) >>
+        32;
+    return static_cast<uint32_t>(x);
+}
+
+#if defined(__SSSE3__) || defined(__AVX__)
+/* the sixteen digits at str, if they are all digits. */
+inline bool sixteen_digits_value(char const *str, uint64_t &value) noexcept {
+    auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(str));
+    auto const d = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+    auto const bad = _mm_or_si128(_mm_cmplt_epi8(d, _mm_setzero_si128()),
+                                  _mm_cmpgt_epi8(d, _mm_set1_epi8(9)));
+    if (_mm_movemask_epi8(bad))
+        return false;
+
+    auto const d2 = _mm_maddubs_epi16(
+        d, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    auto const d4 = _mm_madd_epi16(d2, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    auto const d8 = _mm_madd_epi16(
+        _mm_packs_epi32(d4, d4), _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+    value = uint64_t{static_cast<uint32_t>(_mm_cvtsi128_si32(d8))} * 100000000 +
+            static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(d8, 4)));
+    return true;
+}
+#endif
+
+constexpr std::optional<uint64_t> parse_decimal(char const *str,
+                                                char const *str_end) noexcept {
+    constexpr auto max_digits = std::numeric_limits<uint64_t>::digits10 + 1;
+    constexpr auto max = std::numeric_limits<uint64_t>::max();
+
+    if (str == str_end)
+        return std::nullopt;
+    while (str != str_end && *str == '0')
+        ++str;
+
+    auto const n = static_cast<size_t>(str_end - str);
+    if (n > max_digits)
+        return std::nullopt;
+
+    uint64_t value = 0;
+    auto add_digit = [&](char c) {
+        auto const d = static_cast<unsigned char>(c - '0');
+        if (d > 9 || (n == max_digits && value > (max - d) / 10))
+            return false;
+        value = value * 10 + d;
+        return true;
+    };
+
+    /* short numbers are cheaper one digit at a time. */
+    if (n < 8) {
+        for (; str != str_end; ++str)
+            if (!add_digit(*str))
+                return std::nullopt;
+        return value;
+    }
+
+#if defined(__SSSE3__) || defined(__AVX__)
+    if (n >= 16 && !is_constant_evaluated()) {
+        if (!sixteen_digits_value(str, value))
+            return std::nullopt;
+        for (str += 16; str != str_end; ++str)
+            if (!add_digit(*str))
+                return std::nullopt;
+        return value;
+    }
+#endif
+
+    /* the leading n % 8 digits are read as a full word, shifted so that the
+     * bytes past them are dropped and zeros take their place. */
+    auto const k = (n - 1) % 8 + 1;
+    auto const head =
+        load_digits(str) << (8 * (8 - k)) | (k < 8 ? ascii_zeros >> (8 * k) : 0);
+    if (!all_digits(head))
+        return std::nullopt;
+    value = digits_value(head);
+
+    for (str += k; str != str_end; str += 8) {
+        auto const x = load_digits(str);
+        if (!all_digits(x))
+            return std::nullopt;
+
+        auto const chunk = digits_value(x);
+        if (n == max_digits && value > (max - chunk) / 100000000)
+            return std::nullopt;
+        value = value * 100000000 + chunk;
+    }
+    return value;
+}
+
+/* value of each hexadecimal digit, 0xff for anything else. */
+inline constexpr auto hex_digit_values = [] {
+    std::array<uint8_t, 256> values{};
+    for (auto &v : values)
+        v = 0xff;
+    for (int c = 0; c < 10; ++c)
+        values['0' + c] = static_cast<uint8_t>(c);
+    for (int c = 0; c < 6; ++c)
+        values['a' + c] = values['A' + c] = static_cast<uint8_t>(10 + c);
+    return values;
+}();
+
+/* digits in base 2^bits_per_digit. */
+constexpr std::optional<uint64_t> parse_pow2_base(char const *str, char const *str_end,
+                                                  unsigned bits_per_digit) noexcept {
+    if (str == str_end)
+        return std::nullopt;
+
+    uint64_t value = 0;
+    for (; str != str_end; ++str) {
+        auto const d = hex_digit_values[static_cast<unsigned char>(*str)];
+        if (d >> bits_per_digit || value >> (64 - bits_per_digit))
+            return std::nullopt;
+        value = value << bits_per_digit | d;
+    }
+    return value;
+}
+
+constexpr std::optional<uint64_t> parse_magnitude(char const *str,
+                                                  char const *str_end) noexcept {
+    if (str_end - str > 2 && str[0] == '0') {
+        switch (str[1] | 0x20) {
+        case 'x':
+            return parse_pow2_base(str + 2, str_end, 4);
+        case 'o':
+            return parse_pow2_base(str + 2, str_end, 3);
+        case 'b':
+            return parse_pow2_base(str + 2, str_end, 1);
+        default:
+            break;
+        }
+    }
+    return parse_decimal(str, str_end);
+}
+
+/* Integers as from_chars reads them (a '-' for signed types, then digits and
+ * nothing else), plus base prefixes. Exact range checks for each type, no
+ * locale, no allocation, and usable in constant expressions. */
+template <typename T>
+constexpr std::optional<T> parse_integer(char const *str, char const *str_end) noexcept {
+    constexpr auto max = std::numeric_limits<T>::max();
+    bool const negative = std::is_signed_v<T> && str != str_end && *str == '-';
+    auto const first = str + negative;
+
+    /* up to 32 bits, a number of one to nine digits (without a leading zero, so
+     * without a prefix) is read inline in a 32-bit word, which it cannot
+     * overflow, and range checked once. */
+    if constexpr (std::numeric_limits<T>::digits <= 32) {
+        auto const digits = static_cast<size_t>(str_end - first);
+        if (digits - 1 < 9 && (*first != '0' || digits == 1)) {
+            uint32_t value = 0;
+            auto it = first;
+            if (digits >= 8) {
+                auto const x = load_digits(it);
+                if (!all_digits(x))
+                    return std::nullopt;
+                value = digits_value(x);
+                it += 8;
+            }
+            for (; it != str_end; ++it) {
+                auto const d = static_cast<unsigned char>(*it - '0');
+                if (d > 9)
+                    return std::nullopt;
+                value = value * 10 + d;
+            }
+            if (value > static_cast<uint32_t>(max) + negative)
+                return std::nullopt;
+            /* negated without a branch, as signs do not follow a pattern */
+            return static_cast<T>(negative ? 0 - value : value);
+        }
+    }
+
+    auto const n = parse_magnitude(first, str_end);
+    if (!n || *n > static_cast<uint64_t>(max) + negative)
+        return std::nullopt;
+
+    if (negative && *n)
+        return static_cast<T>(-static_cast<T>(*n - 1) - 1);
+    return static_cast<T>(*n);
+}
+
+/* A floating point literal in from_chars' general format, split into its parts. */
+struct float_literal {
+    enum kind_type { finite, infinity, not_a_number };
+
+    kind_type kind = finite;
+    bool negative = false;
+    /* digits and at most one '.' */
+    char const *mantissa = nullptr, *mantissa_end = nullptr;
+    int64_t exponent = 0;
+
+    /* the first 19 significant digits, as an integer times 10^scale */
+    uint64_t significand = 0;
+    int64_t scale = 0;
+    bool truncated = false; /* nonzero digits follow those */
+};
+
+constexpr bool equal_nocase(char const *str, char const *str_end,
+                            std::string_view lower) noexcept {
+    if (static_cast<size_t>(str_end - str) != lower.size())
+        return false;
+    for (auto c : lower)
+        if ((*str++ | 0x20) != c)
+            return false;
+    return true;
+}
+
+constexpr std::optional<float_literal> scan_float(char const *str,
+                                                  char const *str_end) noexcept {
+    float_literal lit;
+
+    if (str != str_end && *str == '-') {
+        lit.negative = true;
+        ++str;
+    }
+
+    if (str != str_end && !is_digit(*str) && *str != '.') {
+        if (equal_nocase(str, str_end, "inf") || equal_nocase(str, str_end, "infinity")) {
+            lit.kind = float_literal::infinity;
+            return lit;
+        }
+        if (str_end - str >= 3 && equal_nocase(str, str + 3, "nan")) {
+            lit.kind = float_literal::not_a_number;
+            str += 3;
+            if (str == str_end)
+                return lit;
+            if (*str++ != '(')
+                return std::nullopt;
+            for (; str != str_end && *str != ')'; ++str)
+                if (!is_digit(*str) && *str != '_' &&
+                    ((*str | 0x20) < 'a' || (*str | 0x20) > 'z'))
+                    return std::nullopt;
+            if (str != str_end && str + 1 == str_end)
+                return lit;
+            return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    constexpr int max_significant = std::numeric_limits<uint64_t>::digits10;
+    int n_significant = 0;
+    auto scan_digits = [&](bool fraction) {
+        auto const start = str;
+        bool words = true; /* until a word holds something else than digits */
+        while (str != str_end) {
+            if (words && n_significant > 0 && n_significant + 8 <= max_significant &&
+                str_end - str >= 8) {
+                auto const x = load_digits(str);
+                if (all_digits(x)) {
+                    lit.significand = lit.significand * 100000000 + digits_value(x);
+                    n_significant += 8;
+                    lit.scale -= fraction ? 8 : 0;
+                    str += 8;
+                    continue;
+                }
+                words = false;
+            }
+            if (!is_digit(*str))
+                break;
+            auto const d = static_cast<unsigned>(*str++ - '0');
+            if (n_significant == 0 && d == 0) {
+                lit.scale -= fraction;
+            } else if (n_significant < max_significant) {
+                lit.significand = lit.significand * 10 + d;
+                ++n_significant;
+                lit.scale -= fraction;
+            } else {
+                lit.scale += !fraction;
+                lit.truncated = lit.truncated || d;
+            }
+        }
+        return str != start;
+    };
+
+    lit.mantissa = str;
+    bool seen_digit = scan_digits(false);
+    if (str != str_end && *str == '.') {
+        ++str;
+        seen_digit = scan_digits(true) || seen_digit;
+    }
+    if (!seen_digit)
+        return std::nullopt;
+    lit.mantissa_end = str;
+
+    if (str != str_end && (*str | 0x20) == 'e') {
+        bool const negative = ++str != str_end && *str == '-';
+        if (str != str_end && (*str == '-' || *str == '+'))
+            ++str;
+        if (str == str_end)
+            return std::nullopt;
+        for (; str != str_end && is_digit(*str); ++str)
+            if (lit.exponent < 100000) /* far beyond any representable value */
+                lit.exponent = lit.exponent * 10 + (*str - '0');
+        if (negative)
+            lit.exponent = -lit.exponent;
+    }
+    lit.scale += lit.exponent;
+
+    return str == str_end ? std::optional{lit} : std::nullopt;
+}
+
+/* x * 2^e, exact whenever the result is representable. */
+template <typename T>
+constexpr T scale2(T x, int e) noexcept {
+    for (; e >= 32; e -= 32)
+        x *= T(4294967296.0);
+    for (; e <= -32; e += 32)
+        x /= T(4294967296.0);
+    return e >= 0 ? x * T(uint64_t(1) << e) : x / T(uint64_t(1) << -e);
+}
+
+/* Arbitrary precision decimal for converting decimal strings to binary floating
+ * point with correct rounding, however many digits they have (the "simple
+ * decimal conversion" algorithm, as in Go's strconv). Slow but exact, and
+ * usable in constant expressions. */
+class decimal {
+public:
+    constexpr explicit decimal(float_literal const &lit) noexcept
+      : negative(lit.negative) {
+        bool seen_point = false;
+        for (auto c = lit.mantissa; c != lit.mantissa_end; ++c) {
+            if (*c == '.') {
+                seen_point = true;
+                point = n_digits;
+            } else if (*c == '0' && n_digits == 0) {
+                --point; /* leading zeros */
+            } else if (n_digits < max_digits) {
+                digits[n_digits++] = static_cast<uint8_t>(*c - '0');
+            } else if (*c != '0') {
+                truncated = true;
+            }
+        }
+        if (!seen_point)
+            point = n_digits;
+        point += static_cast<int>(lit.exponent);
+    }
+
+    /* the nearest T, ties to even; nullopt if out of range, zero excepted. */
+    template <typename T>
+    constexpr std::optional<T> to_float() noexcept {
+        using limits = std::numeric_limits<T>;
+        constexpr int p = limits::digits;
+        constexpr int min_e = limits::min_exponent - 1, max_e = limits::max_exponent;
+        constexpr int steps[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+        static_assert(p <= 64, "unsupported floating point format");
+
+        if (n_digits == 0)
+            return negative ? -T(0) : T(0);
+        if (point > limits::max_exponent10 + 1 ||
+            point < limits::min_exponent10 - limits::max_digits10 - 8)
+            return std::nullopt;
+
+        /* scale into [1/2, 1), counting powers of two. */
+        int e = 0;
+        while (point > 0) {
+            int const n = point < 9 ? steps[point] : 27;
+            shift(-n);
+            e += n;
+        }
+        while (point < 0 || (point == 0 && digits[0] < 5)) {
+            int const n = -point < 9 ? steps[-point] : 27;
+            shift(n);
+            e -= n;
+        }
+
+        --e; /* [1, 2) */
+        if (e < min_e) {
+            shift(-(min_e - e));
+            e = min_e;
+        }
+        if (e >= max_e)
+            return std::nullopt;
+
+        shift(p);
+        bool const up = round_up(point);
+        uint64_t mantissa = integer_part() + up;
+        constexpr uint64_t overflow = p < 64 ? uint64_t(1) << (p % 64) : 0;
+        if (up && mantissa == overflow) {
+            mantissa = uint64_t(1) << (p - 1);
+            if (++e >= max_e)
+                return std::nullopt;
+        }
+        if (mantissa == 0)
+            return std::nullopt;
+
+        auto const value = scale2(static_cast<T>(mantissa), e - (p - 1));
+        return negative ? -value : value;
+    }
+
+private:
+    static constexpr int max_digits = 800;
+    static constexpr unsigned max_shift = 60;
+
+    constexpr void shift(int k) noexcept {
+        if (n_digits == 0)
+            return;
+        for (; k > static_cast<int>(max_shift); k -= max_shift)
+            left_shift(max_shift);
+        for (; k < -static_cast<int>(max_shift); k += max_shift)
+            right_shift(max_shift);
+        if (k > 0)
+            left_shift(static_cast<unsigned>(k));
+        else if (k < 0)
+            right_shift(static_cast<unsigned>(-k));
+    }
+
+    constexpr void left_shift(unsigned k) noexcept {
+        uint8_t reversed[max_digits + 20] = {};
+        int m = 0;
+        uint64_t n = 0;
+        for (int r = n_digits; r-- > 0;) {
+            n += uint64_t{digits[r]} << k;
+            reversed[m++] = static_cast<uint8_t>(n % 10);
+            n /= 10;
+        }
+        for (; n > 0; n /= 10)
+            reversed[m++] = static_cast<uint8_t>(n % 10);
+
+        point += m - n_digits;
+        int const kept = std::min(m, max_digits);
+        for (int i = 0; i < m - kept; ++i)
+            truncated = truncated || reversed[i];
+        for (int i = 0; i < kept; ++i)
+            digits[i] = reversed[m - 1 - i];
+        n_digits = kept;
+        trim();
+    }
+
+    constexpr void right_shift(unsigned k) noexcept {
+        int r = 0, w = 0;
+        uint64_t n = 0;
+        for (; (n >> k) == 0; ++r) {
+            if (r >= n_digits) {
+                if (n == 0) {
+                    n_digits = 0;
+                    return;
+                }
+                for (; (n >> k) == 0; ++r)
+                    n *= 10;
+                break;
+            }
+            n = n * 10 + digits[r];
+        }
+        point -= r - 1;
+
+        uint64_t const mask = (uint64_t(1) << k) - 1;
+        for (; r < n_digits; ++r) {
+            digits[w++] = static_cast<uint8_t>(n >> k);
+            n = (n & mask) * 10 + digits[r];
+        }
+        for (; n > 0; n = (n & mask) * 10) {
+            auto const d = static_cast<uint8_t>(n >> k);
+            if (w < max_digits)
+                digits[w++] = d;
+            else
+                truncated = truncated || d;
+        }
+        n_digits = w;
+        trim();
+    }
+
+    constexpr void trim() noexcept {
+        while (n_digits > 0 && digits[n_digits - 1] == 0)
+            --n_digits;
+        if (n_digits == 0)
+            point = 0;
+    }
+
+    constexpr bool round_up(int nd) const noexcept {
+        if (nd < 0 || nd >= n_digits)
+            return false;
+        if (digits[nd] == 5 && nd + 1 == n_digits) /* exactly halfway, unless truncated */
+            return truncated || (nd > 0 && digits[nd - 1] % 2);
+        return digits[nd] >= 5;
+    }
+
+    constexpr uint64_t integer_part() const noexcept {
+        uint64_t n = 0;
+        int i = 0;
+        for (; i < point && i < n_digits; ++i)
+            n = n * 10 + digits[i];
+        for (; i < point; ++i)
+            n *= 10;
+        return n;
+    }
+
+    int n_digits = 0;
+    int point = 0; /* digits[0] is worth 10^(point - 1) */
+    bool negative = false;
+    bool truncated = false; /* nonzero digits were dropped past max_digits */
+    uint8_t digits[max_digits] = {};
+};
+
+/* The 128 leading bits of 5^q for q in [smallest, largest], rounded down for
+ * q >= 0 and up for q < 0 (the table fast_float and Eisel-Lemire use), as
+ * high/low word pairs. Precomputed with big integers, as building it in a
+ * constant expression slowed down every translation unit that parsed floats. */
+struct powers_of_five {
+    static constexpr int smallest = -342, largest = 308;
+    static constexpr uint64_t table[2 * (largest - smallest + 1)] = {
+    0xeef453d6923bd65a, 0x113faa2906a13b3f, 0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+    0xbaaee17fa23ebf76, 0x5d79bcf00d2df649, 0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+    0x91d8a02bb6c10594, 0x79071b9b8a4be869, 0xb64ec836a47146f9, 0x9748e2826cdee284,
+    0xe3e27a444d8d98b7, 0xfd1b1b2308169b25, 0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+    0xb208ef855c969f4f, 0xbdbd2d335e51a935, 0xde8b2b66b3bc4723, 0xad2c788035e61382,
+    0x8b16fb203055ac76, 0x4c3bcb5021afcc31, 0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+    0xd953e8624b85dd78, 0xd71d6dad34a2af0d, 0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+    0xa9c98d8ccb009506, 0x680efdaf511f18c2, 0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+    0x84a57695fe98746d, 0x014bb630f7604b57, 0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+    0xcf42894a5dce35ea, 0x52064cac828675b9, 0x818995ce7aa0e1b2, 0x7343efebd1940993,
+    0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8, 0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+    0xfd00b897478238d0, 0x8920b098955522b4, 0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+    0xc5a890362fddbc62, 0xeb2189f734aa831d, 0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+    0x9a6bb0aa55653b2d, 0x47b233c92125366e, 0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+    0xf148440a256e2c76, 0xc00670ea43ca250d, 0x96cd2a865764dbca, 0x380406926a5e5728,
+    0xbc807527ed3e12bc, 0xc605083704f5ecf2, 0xeba09271e88d976b, 0xf7864a44c633682e,
+    0x93445b8731587ea3, 0x7ab3ee6afbe0211d, 0xb8157268fdae9e4c, 0x5960ea05bad82964,
+    0xe61acf033d1a45df, 0x6fb92487298e33bd, 0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+    0xb3c4f1ba87bc8696, 0x8f48a4899877186c, 0xe0b62e2929aba83c, 0x331acdabfe94de87,
+    0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14, 0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+    0xdb71e91432b1a24a, 0xc9e82cd9f69d6150, 0x892731ac9faf056e, 0xbe311c083a225cd2,
+    0xab70fe17c79ac6ca, 0x6dbd630a48aaf406, 0xd64d3d9db981787d, 0x092cbbccdad5b108,
+    0x85f0468293f0eb4e, 0x25bbf56008c58ea5, 0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+    0xd1476e2c07286faa, 0x1af5af660db4aee1, 0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+    0xa37fce126597973c, 0xe50ff107bab528a0, 0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+    0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a, 0x9faacf3df73609b1, 0x77b191618c54e9ac,
+    0xc795830d75038c1d, 0xd59df5b9ef6a2417, 0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+    0x9becce62836ac577, 0x4ee367f9430aec32, 0xc2e801fb244576d5, 0x229c41f793cda73f,
+    0xf3a20279ed56d48a, 0x6b43527578c1110f, 0x9845418c345644d6, 0x830a13896b78aaa9,
+    0xbe5691ef416bd60c, 0x23cc986bc656d553, 0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+    0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9, 0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+    0xe858ad248f5c22c9, 0xd1b3400f8f9cff68, 0x91376c36d99995be, 0x23100809b9c21fa1,
+    0xb58547448ffffb2d, 0xabd40a0c2832a78a, 0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+    0x8dd01fad907ffc3b, 0xae3da7d97f6792e3, 0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+    0xdd95317f31c7fa1d, 0x40405643d711d583, 0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+    0xad1c8eab5ee43b66, 0xda3243650005eecf, 0xd863b256369d4a40, 0x90bed43e40076a82,
+    0x873e4f75e2224e68, 0x5a7744a6e804a291, 0xa90de3535aaae202, 0x711515d0a205cb36,
+    0xd3515c2831559a83, 0x0d5a5b44ca873e03, 0x8412d9991ed58091, 0xe858790afe9486c2,
+    0xa5178fff668ae0b6, 0x626e974dbe39a872, 0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+    0x80fa687f881c7f8e, 0x7ce66634bc9d0b99, 0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+    0xc987434744ac874e, 0xa327ffb266b56220, 0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+    0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9, 0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+    0xf6019da07f549b2b, 0x7e2a53a146606a48, 0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+    0xc0314325637a1939, 0xfa911155fefb5308, 0xf03d93eebc589f88, 0x793555ab7eba27ca,
+    0x96267c7535b763b5, 0x4bc1558b2f3458de, 0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+    0xea9c227723ee8bcb, 0x465e15a979c1cadc, 0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+    0xb749faed14125d36, 0xcef980ec671f667b, 0xe51c79a85916f484, 0x82b7e12780e7401a,
+    0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810, 0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+    0xdfbdcece67006ac9, 0x67a791e093e1d49a, 0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+    0xaecc49914078536d, 0x58fae9f773886e18, 0xda7f5bf590966848, 0xaf39a475506a899e,
+    0x888f99797a5e012d, 0x6d8406c952429603, 0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+    0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64, 0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+    0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e, 0xd0601d8efc57b08b, 0xf13b94daf124da26,
+    0x823c12795db6ce57, 0x76c53d08d6b70858, 0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+    0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09, 0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+    0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf, 0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+    0xf867241c8cc6d4c0, 0xc30163d203c94b62, 0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+    0xc21094364dfb5636, 0x985915fc12f542e4, 0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+    0x979cf3ca6cec5b5a, 0xa705992ceecf9c42, 0xbd8430bd08277231, 0x50c6ff782a838353,
+    0xece53cec4a314ebd, 0xa4f8bf5635246428, 0x940f4613ae5ed136, 0x871b7795e136be99,
+    0xb913179899f68584, 0x28e2557b59846e3f, 0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+    0x9096ea6f3848984f, 0x3ff0d2c85def7621, 0xb4bca50b065abe63, 0x0fed077a756b53a9,
+    0xe1ebce4dc7f16dfb, 0xd3e8495912c62894, 0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+    0xb080392cc4349dec, 0xbd8d794d96aacfb3, 0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+    0x89e42caaf9491b60, 0xf41686c49db57244, 0xac5d37d5b79b6239, 0x311c2875c522ced5,
+    0xd77485cb25823ac7, 0x7d633293366b828b, 0x86a8d39ef77164bc, 0xae5dff9c02033197,
+    0xa8530886b54dbdeb, 0xd9f57f830283fdfc, 0xd267caa862a12d66, 0xd072df63c324fd7b,
+    0x8380dea93da4bc60, 0x4247cb9e59f71e6d, 0xa46116538d0deb78, 0x52d9be85f074e608,
+    0xcd795be870516656, 0x67902e276c921f8b, 0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+    0xa086cfcd97bf97f3, 0x80e8a40eccd228a4, 0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+    0xfad2a4b13d1b5d6c, 0x796b805720085f81, 0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+    0xc3f490aa77bd60fc, 0xbedbfc4411068a9c, 0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+    0x991711052d8bf3c5, 0x751bdd152d4d1c4a, 0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+    0xef340a98172aace4, 0x86fb897116c87c34, 0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+    0xbae0a846d2195712, 0x8974836059cca109, 0xe998d258869facd7, 0x2bd1a438703fc94b,
+    0x91ff83775423cc06, 0x7b6306a34627ddcf, 0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+    0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93, 0x8e938662882af53e, 0x547eb47b7282ee9c,
+    0xb23867fb2a35b28d, 0xe99e619a4f23aa43, 0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+    0x8b3c113c38f9f37e, 0xde83bc408dd3dd04, 0xae0b158b4738705e, 0x9624ab50b148d445,
+    0xd98ddaee19068c76, 0x3badd624dd9b0957, 0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+    0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c, 0xd47487cc8470652b, 0x7647c3200069671f,
+    0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073, 0xa5fb0a17c777cf09, 0xf468107100525890,
+    0xcf79cc9db955c2cc, 0x7182148d4066eeb4, 0x81ac1fe293d599bf, 0xc6f14cd848405530,
+    0xa21727db38cb002f, 0xb8ada00e5a506a7c, 0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+    0xfd442e4688bd304a, 0x908f4a166d1da663, 0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+    0xc5dd44271ad3cdba, 0x40eff1e1853f29fd, 0xf7549530e188c128, 0xd12bee59e68ef47c,
+    0x9a94dd3e8cf578b9, 0x82bb74f8301958ce, 0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+    0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1, 0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+    0xbcb2b812db11a5de, 0x7415d448f6b6f0e7, 0xebdf661791d60f56, 0x111b495b3464ad21,
+    0x936b9fcebb25c995, 0xcab10dd900beec34, 0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+    0xe65829b3046b0afa, 0x0cb4a5a3112a5112, 0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+    0xb3f4e093db73a093, 0x59ed216765690f56, 0xe0f218b8d25088b8, 0x306869c13ec3532c,
+    0x8c974f7383725573, 0x1e414218c73a13fb, 0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+    0xdbac6c247d62a583, 0xdf45f746b74abf39, 0x894bc396ce5da772, 0x6b8bba8c328eb783,
+    0xab9eb47c81f5114f, 0x066ea92f3f326564, 0xd686619ba27255a2, 0xc80a537b0efefebd,
+    0x8613fd0145877585, 0xbd06742ce95f5f36, 0xa798fc4196e952e7, 0x2c48113823b73704,
+    0xd17f3b51fca3a7a0, 0xf75a15862ca504c5, 0x82ef85133de648c4, 0x9a984d73dbe722fb,
+    0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba, 0xcc963fee10b7d1b3, 0x318df905079926a8,
+    0xffbbcfe994e5c61f, 0xfdf17746497f7052, 0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+    0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0, 0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+    0x9c1661a651213e2d, 0x06bea10ca65c084e, 0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+    0xf3e2f893dec3f126, 0x5a89dba3c3efccfa, 0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+    0xbe89523386091465, 0xf6bbb397f1135823, 0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+    0x94db483840b717ef, 0xa8c2a44eb4571cdc, 0xba121a4650e4ddeb, 0x92f34d62616ce413,
+    0xe896a0d7e51e1566, 0x77b020baf9c81d17, 0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+    0xb5b5ada8aaff80b8, 0x0d819992132456ba, 0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+    0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1, 0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+    0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde, 0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+    0xad4ab7112eb3929d, 0x86c16c98d2c953c6, 0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+    0x87625f056c7c4a8b, 0x11471cd764ad4972, 0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+    0xd389b47879823479, 0x4aff1d108d4ec2c3, 0x843610cb4bf160cb, 0xcedf722a585139ba,
+    0xa54394fe1eedb8fe, 0xc2974eb4ee658828, 0xce947a3da6a9273e, 0x733d226229feea32,
+    0x811ccc668829b887, 0x0806357d5a3f525f, 0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+    0xc9bcff6034c13052, 0xfc89b393dd02f0b5, 0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+    0x9d9ba7832936edc0, 0xd54b944b84aa4c0d, 0xc5029163f384a931, 0x0a9e795e65d4df11,
+    0xf64335bcf065d37d, 0x4d4617b5ff4a16d5, 0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+    0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6, 0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+    0x964e858c91ba2655, 0x3a6a07f8d510f86f, 0xbbe226efb628afea, 0x890489f70a55368b,
+    0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e, 0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+    0xb77ada0617e3bbcb, 0x09ce6ebb40173744, 0xe55990879ddcaabd, 0xcc420a6a101d0515,
+    0x8f57fa54c2a9eab6, 0x9fa946824a12232d, 0xb32df8e9f3546564, 0x47939822dc96abf9,
+    0xdff9772470297ebd, 0x59787e2b93bc56f7, 0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+    0xaefae51477a06b03, 0xede622920b6b23f1, 0xdab99e59958885c4, 0xe95fab368e45eced,
+    0x88b402f7fd75539b, 0x11dbcb0218ebb414, 0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+    0xd59944a37c0752a2, 0x4be76d3346f0495f, 0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+    0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952, 0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+    0x825ecc24c873782f, 0x8ed400668c0c28c8, 0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+    0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9, 0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+    0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9, 0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+    0xf8a95fcf88747d94, 0x75a44c6397ce912a, 0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+    0xc24452da229b021b, 0xfbe85badce996168, 0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+    0x97c560ba6b0919a5, 0xdccd879fc967d41a, 0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+    0xed246723473e3813, 0x290123e9aab23b68, 0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+    0xb94470938fa89bce, 0xf808e40e8d5b3e69, 0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+    0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2, 0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+    0xe2280b6c20dd5232, 0x25c6da63c38de1b0, 0x8d590723948a535f, 0x579c487e5a38ad0e,
+    0xb0af48ec79ace837, 0x2d835a9df0c6d851, 0xdcdb1b2798182244, 0xf8e431456cf88e65,
+    0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff, 0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+    0xd7adf884aa879177, 0x5b0ed81dcc6abb0f, 0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+    0xa87fea27a539e9a5, 0x3f2398d747b36224, 0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+    0x83a3eeeef9153e89, 0x1953cf68300424ac, 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+    0xcdb02555653131b6, 0x3792f412cb06794d, 0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+    0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4, 0xc8de047564d20a8b, 0xf245825a5a445275,
+    0xfb158592be068d2e, 0xeed6e2f0f0d56712, 0x9ced737bb6c4183d, 0x55464dd69685606b,
+    0xc428d05aa4751e4c, 0xaa97e14c3c26b886, 0xf53304714d9265df, 0xd53dd99f4b3066a8,
+    0x993fe2c6d07b7fab, 0xe546a8038efe4029, 0xbf8fdb78849a5f96, 0xde98520472bdd033,
+    0xef73d256a5c0f77c, 0x963e66858f6d4440, 0x95a8637627989aad, 0xdde7001379a44aa8,
+    0xbb127c53b17ec159, 0x5560c018580d5d52, 0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+    0x9226712162ab070d, 0xcab3961304ca70e8, 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+    0xe45c10c42a2b3b05, 0x8cb89a7db77c506a, 0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+    0xb267ed1940f1c61c, 0x55f038b237591ed3, 0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+    0x8b61313bbabce2c6, 0x2323ac4b3b3da015, 0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+    0xd9c7dced53c72255, 0x96e7bd358c904a21, 0x881cea14545c7575, 0x7e50d64177da2e54,
+    0xaa242499697392d2, 0xdde50bd1d5d0b9e9, 0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+    0x84ec3c97da624ab4, 0xbd5af13bef0b113e, 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+    0xcfb11ead453994ba, 0x67de18eda5814af2, 0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+    0xa2425ff75e14fc31, 0xa1258379a94d028d, 0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+    0xfd87b5f28300ca0d, 0x8bca9d6e188853fc, 0x9e74d1b791e07e48, 0x775ea264cf55347e,
+    0xc612062576589dda, 0x95364afe032a819e, 0xf79687aed3eec551, 0x3a83ddbd83f52205,
+    0x9abe14cd44753b52, 0xc4926a9672793543, 0xc16d9a0095928a27, 0x75b7053c0f178294,
+    0xf1c90080baf72cb1, 0x5324c68b12dd6339, 0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+    0xbce5086492111aea, 0x88f4bb1ca6bcf585, 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+    0x9392ee8e921d5d07, 0x3aff322e62439fd0, 0xb877aa3236a4b449, 0x09befeb9fad487c3,
+    0xe69594bec44de15b, 0x4c2ebe687989a9b4, 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+    0xb424dc35095cd80f, 0x538484c19ef38c95, 0xe12e13424bb40e13, 0x2865a5f206b06fba,
+    0x8cbccc096f5088cb, 0xf93f87b7442e45d4, 0xafebff0bcb24aafe, 0xf78f69a51539d749,
+    0xdbe6fecebdedd5be, 0xb573440e5a884d1c, 0x89705f4136b4a597, 0x31680a88f8953031,
+    0xabcc77118461cefc, 0xfdc20d2b36ba7c3e, 0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+    0x8637bd05af6c69b5, 0xa63f9a49c2c1b110, 0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+    0xd1b71758e219652b, 0xd3c36113404ea4a9, 0x83126e978d4fdf3b, 0x645a1cac083126ea,
+    0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4, 0xcccccccccccccccc, 0xcccccccccccccccd,
+    0x8000000000000000, 0x0000000000000000, 0xa000000000000000, 0x0000000000000000,
+    0xc800000000000000, 0x0000000000000000, 0xfa00000000000000, 0x0000000000000000,
+    0x9c40000000000000, 0x0000000000000000, 0xc350000000000000, 0x0000000000000000,
+    0xf424000000000000, 0x0000000000000000, 0x9896800000000000, 0x0000000000000000,
+    0xbebc200000000000, 0x0000000000000000, 0xee6b280000000000, 0x0000000000000000,
+    0x9502f90000000000, 0x0000000000000000, 0xba43b74000000000, 0x0000000000000000,
+    0xe8d4a51000000000, 0x0000000000000000, 0x9184e72a00000000, 0x0000000000000000,
+    0xb5e620f480000000, 0x0000000000000000, 0xe35fa931a0000000, 0x0000000000000000,
+    0x8e1bc9bf04000000, 0x0000000000000000, 0xb1a2bc2ec5000000, 0x0000000000000000,
+    0xde0b6b3a76400000, 0x0000000000000000, 0x8ac7230489e80000, 0x0000000000000000,
+    0xad78ebc5ac620000, 0x0000000000000000, 0xd8d726b7177a8000, 0x0000000000000000,
+    0x878678326eac9000, 0x0000000000000000, 0xa968163f0a57b400, 0x0000000000000000,
+    0xd3c21bcecceda100, 0x0000000000000000, 0x84595161401484a0, 0x0000000000000000,
+    0xa56fa5b99019a5c8, 0x0000000000000000, 0xcecb8f27f4200f3a, 0x0000000000000000,
+    0x813f3978f8940984, 0x4000000000000000, 0xa18f07d736b90be5, 0x5000000000000000,
+    0xc9f2c9cd04674ede, 0xa400000000000000, 0xfc6f7c4045812296, 0x4d00000000000000,
+    0x9dc5ada82b70b59d, 0xf020000000000000, 0xc5371912364ce305, 0x6c28000000000000,
+    0xf684df56c3e01bc6, 0xc732000000000000, 0x9a130b963a6c115c, 0x3c7f400000000000,
+    0xc097ce7bc90715b3, 0x4b9f100000000000, 0xf0bdc21abb48db20, 0x1e86d40000000000,
+    0x96769950b50d88f4, 0x1314448000000000, 0xbc143fa4e250eb31, 0x17d955a000000000,
+    0xeb194f8e1ae525fd, 0x5dcfab0800000000, 0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+    0xb7abc627050305ad, 0xf14a3d9e40000000, 0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+    0x8f7e32ce7bea5c6f, 0xe4820023a2000000, 0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+    0xe0352f62a19e306e, 0xd50b2037ad200000, 0x8c213d9da502de45, 0x4526f422cc340000,
+    0xaf298d050e4395d6, 0x9670b12b7f410000, 0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+    0x88d8762bf324cd0f, 0xa5880a69fb6ac800, 0xab0e93b6efee0053, 0x8eea0d047a457a00,
+    0xd5d238a4abe98068, 0x72a4904598d6d880, 0x85a36366eb71f041, 0x47a6da2b7f864750,
+    0xa70c3c40a64e6c51, 0x999090b65f67d924, 0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+    0x82818f1281ed449f, 0xbff8f10e7a8921a4, 0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+    0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490, 0xfee50b7025c36a08, 0x02f236d04753d5b4,
+    0x9f4f2726179a2245, 0x01d762422c946590, 0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+    0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2, 0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+    0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb, 0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+    0x97edd871cfda3a56, 0x97758bf0e3cbb5ac, 0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+    0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd, 0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+    0xb975d6b6ee39e436, 0xb3e2fd538e122b44, 0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+    0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd, 0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+    0xe264589a4dcdab14, 0xc696963c7eed2dd1, 0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+    0xb0de65388cc8ada8, 0x3b25a55f43294bcb, 0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+    0x8a2dbf142dfcc7ab, 0x6e3569326c784337, 0xacb92ed9397bf996, 0x49c2c37f07965404,
+    0xd7e77a8f87daf7fb, 0xdc33745ec97be906, 0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+    0xa8acd7c0222311bc, 0xc40832ea0d68ce0c, 0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+    0x83c7088e1aab65db, 0x792667c6da79e0fa, 0xa4b8cab1a1563f52, 0x577001b891185938,
+    0xcde6fd5e09abcf26, 0xed4c0226b55e6f86, 0x80b05e5ac60b6178, 0x544f8158315b05b4,
+    0xa0dc75f1778e39d6, 0x696361ae3db1c721, 0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+    0xfb5878494ace3a5f, 0x04ab48a04065c723, 0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+    0xc45d1df942711d9a, 0x3ba5d0bd324f8394, 0xf5746577930d6500, 0xca8f44ec7ee36479,
+    0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb, 0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+    0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e, 0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+    0xbb445da9ca61281f, 0x2a8a6e45ae8edc97, 0xea1575143cf97226, 0xf52d09d71a3293bd,
+    0x924d692ca61be758, 0x593c2626705f9c56, 0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+    0xe498f455c38b997a, 0x0b6dfb9c0f956447, 0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+    0xb2977ee300c50fe7, 0x58edec91ec2cb657, 0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+    0x8b865b215899f46c, 0xbd79e0d20082ee74, 0xae67f1e9aec07187, 0xecd8590680a3aa11,
+    0xda01ee641a708de9, 0xe80e6f4820cc9495, 0x884134fe908658b2, 0x3109058d147fdcdd,
+    0xaa51823e34a7eede, 0xbd4b46f0599fd415, 0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+    0x850fadc09923329e, 0x03e2cf6bc604ddb0, 0xa6539930bf6bff45, 0x84db8346b786151c,
+    0xcfe87f7cef46ff16, 0xe612641865679a63, 0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+    0xa26da3999aef7749, 0xe3be5e330f38f09d, 0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+    0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6, 0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+    0xc646d63501a1511d, 0xb281e1fd541501b8, 0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+    0x9ae757596946075f, 0x3375788de9b06958, 0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+    0xf209787bb47d6b84, 0xc0678c5dbd23a49a, 0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+    0xbd176620a501fbff, 0xb650e5a93bc3d898, 0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+    0x93ba47c980e98cdf, 0xc66f336c36b10137, 0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+    0xe6d3102ad96cec1d, 0xa60dc059157491e5, 0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+    0xb454e4a179dd1877, 0x29babe4598c311fb, 0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+    0x8ce2529e2734bb1d, 0x1899e4a65f58660c, 0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+    0xdc21a1171d42645d, 0x76707543f4fa1f73, 0x899504ae72497eba, 0x6a06494a791c53a8,
+    0xabfa45da0edbde69, 0x0487db9d17636892, 0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+    0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2, 0xa7f26836f282b732, 0x8e6cac7768d7141e,
+    0xd1ef0244af2364ff, 0x3207d795430cd926, 0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+    0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6, 0xcd036837130890a1, 0x36dba887c37a8c0f,
+    0x802221226be55a64, 0xc2494954da2c9789, 0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+    0xc83553c5c8965d3d, 0x6f92829494e5acc7, 0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+    0x9c69a97284b578d7, 0xff2a760414536efb, 0xc38413cf25e2d70d, 0xfef5138519684aba,
+    0xf46518c2ef5b8cd1, 0x7eb258665fc25d69, 0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+    0xbeeefb584aff8603, 0xaafb550ffacfd8fa, 0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+    0x952ab45cfa97a0b2, 0xdd945a747bf26183, 0xba756174393d88df, 0x94f971119aeef9e4,
+    0xe912b9d1478ceb17, 0x7a37cd5601aab85d, 0x91abb422ccb812ee, 0xac62e055c10ab33a,
+    0xb616a12b7fe617aa, 0x577b986b314d6009, 0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+    0x8e41ade9fbebc27d, 0x14588f13be847307, 0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+    0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb, 0x8aec23d680043bee, 0x25de7bb9480d5854,
+    0xada72ccc20054ae9, 0xaf561aa79a10ae6a, 0xd910f7ff28069da4, 0x1b2ba1518094da04,
+    0x87aa9aff79042286, 0x90fb44d2f05d0842, 0xa99541bf57452b28, 0x353a1607ac744a53,
+    0xd3fa922f2d1675f2, 0x42889b8997915ce8, 0x847c9b5d7c2e09b7, 0x69956135febada11,
+    0xa59bc234db398c25, 0x43fab9837e699095, 0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+    0x8161afb94b44f57d, 0x1d1be0eebac278f5, 0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+    0xca28a291859bbf93, 0x7d7b8f7503cfdcfe, 0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+    0x9defbf01b061adab, 0x3a0888136afa64a7, 0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+    0xf6c69a72a3989f5b, 0x8aad549e57273d45, 0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+    0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd, 0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+    0x969eb7c47859e743, 0x9f644ae5a4b1b325, 0xbc4665b596706114, 0x873d5d9f0dde1fee,
+    0xeb57ff22fc0c7959, 0xa90cb506d155a7ea, 0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+    0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f, 0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+    0x8fa475791a569d10, 0xf96e017d694487bc, 0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+    0xe070f78d3927556a, 0x85bbe253f47b1417, 0x8c469ab843b89562, 0x93956d7478ccec8e,
+    0xaf58416654a6babb, 0x387ac8d1970027b2, 0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+    0x88fcf317f22241e2, 0x441fece3bdf81f03, 0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+    0xd60b3bd56a5586f1, 0x8a71e223d8d3b074, 0x85c7056562757456, 0xf6872d5667844e49,
+    0xa738c6bebb12d16c, 0xb428f8ac016561db, 0xd106f86e69d785c7, 0xe13336d701beba52,
+    0x82a45b450226b39c, 0xecc0024661173473, 0xa34d721642b06084, 0x27f002d7f95d0190,
+    0xcc20ce9bd35c78a5, 0x31ec038df7b441f4, 0xff290242c83396ce, 0x7e67047175a15271,
+    0x9f79a169bd203e41, 0x0f0062c6e984d386, 0xc75809c42c684dd1, 0x52c07b78a3e60868,
+    0xf92e0c3537826145, 0xa7709a56ccdf8a82, 0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+    0xc2abf989935ddbfe, 0x6acff893d00ea435, 0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+    0x98165af37b2153de, 0xc3727a337a8b704a, 0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+    0xeda2ee1c7064130c, 0x1162def06f79df73, 0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+    0xb9a74a0637ce2ee1, 0x6d953e2bd7173692, 0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+    0x910ab1d4db9914a0, 0x1d9c9892400a22a2, 0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+    0xe2a0b5dc971f303a, 0x2e44ae64840fd61d, 0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+    0xb10d8e1456105dad, 0x7425a83e872c5f47, 0xdd50f1996b947518, 0xd12f124e28f77719,
+    0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f, 0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+    0xd8210befd30efa5a, 0x3c47f7e05401aa4e, 0x8714a775e3e95c78, 0x65acfaec34810a71,
+    0xa8d9d1535ce3b396, 0x7f1839a741a14d0d, 0xd31045a8341ca07c, 0x1ede48111209a050,
+    0x83ea2b892091e44d, 0x934aed0aab460432, 0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+    0xce1de40642e3f4b9, 0x36251260ab9d668e, 0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+    0xa1075a24e4421730, 0xb24cf65b8612f81f, 0xc94930ae1d529cfc, 0xdee033f26797b627,
+    0xfb9b7cd9a4a7443c, 0x169840ef017da3b1, 0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+    0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2, 0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+    0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29, 0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+    0xeff394dcff8a948e, 0xddfc4b4cef07f5b0, 0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+    0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1, 0xea53df5fd18d5513, 0x84c86189216dc5ed,
+    0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4, 0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+    0xe4d5e82392a40515, 0x0fabaf3feaa5334a, 0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+    0xb2c71d5bca9023f8, 0x743e20e9ef511012, 0xdf78e4b2bd342cf6, 0x914da9246b255416,
+    0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e, 0xae9672aba3d0c320, 0xa184ac2473b529b1,
+    0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e, 0x8865899617fb1871, 0x7e2fa67c7a658892,
+    0xaa7eebfb9df9de8d, 0xddbb901b98feeab7, 0xd51ea6fa85785631, 0x552a74227f3ea565,
+    0x8533285c936b35de, 0xd53a88958f87275f, 0xa67ff273b8460356, 0x8a892abaf368f137,
+    0xd01fef10a657842c, 0x2d2b7569b0432d85, 0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+    0xa298f2c501f45f42, 0x8349f3ba91b47b8f, 0xcb3f2f7642717713, 0x241c70a936219a73,
+    0xfe0efb53d30dd4d7, 0xed238cd383aa0110, 0x9ec95d1463e8a506, 0xf4363804324a40aa,
+    0xc67bb4597ce2ce48, 0xb143c6053edcd0d5, 0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+    0x9b10a4e5e9913128, 0xca7cf2b4191c8326, 0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+    0xf24a01a73cf2dccf, 0xbc633b39673c8cec, 0x976e41088617ca01, 0xd5be0503e085d813,
+    0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18, 0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+    0x93e1ab8252f33b45, 0xcabb90e5c942b503, 0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+    0xe7109bfba19c0c9d, 0x0cc512670a783ad4, 0x906a617d450187e2, 0x27fb2b80668b24c5,
+    0xb484f9dc9641e9da, 0xb1f9f660802dedf6, 0xe1a63853bbd26451, 0x5e7873f8a0396973,
+    0x8d07e33455637eb2, 0xdb0b487b6423e1e8, 0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+    0xdc5c5301c56b75f7, 0x7641a140cc7810fb, 0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+    0xac2820d9623bf429, 0x546345fa9fbdcd44, 0xd732290fbacaf133, 0xa97c177947ad4095,
+    0x867f59a9d4bed6c0, 0x49ed8eabcccc485d, 0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+    0xd226fc195c6a2f8c, 0x73832eec6fff3111, 0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+    0xa42e74f3d032f525, 0xba3e7ca8b77f5e55, 0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+    0x80444b5e7aa7cf85, 0x7980d163cf5b81b3, 0xa0555e361951c366, 0xd7e105bcc332621f,
+    0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7, 0xfa856334878fc150, 0xb14f98f6f0feb951,
+    0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3, 0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+    0xf4a642e14c6262c8, 0xcd27bb612758c0fa, 0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+    0xbf21e44003acdd2c, 0xe0470a63e6bd56c3, 0xeeea5d5004981478, 0x1858ccfce06cac74,
+    0x95527a5202df0ccb, 0x0f37801e0c43ebc8, 0xbaa718e68396cffd, 0xd30560258f54e6ba,
+    0xe950df20247c83fd, 0x47c6b82ef32a2069, 0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+    0xb6472e511c81471d, 0xe0133fe4adf8e952, 0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+    0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648
+    };
+};
+
+struct product128 {
+    uint64_t high, low;
+};
+
+constexpr product128 multiply_full(uint64_t a, uint64_t b) noexcept {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    auto const r = uint128{a} * b;
+    return {static_cast<uint64_t>(r >> 64), static_cast<uint64_t>(r)};
+#else
+    uint64_t const a_lo = a & 0xffffffffu, a_hi = a >> 32, b_lo = b & 0xffffffffu,
+                   b_hi = b >> 32;
+    uint64_t const lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi,
+                   hi_hi = a_hi * b_hi;
+    uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+    return {(hi_lo >> 32) + (cross >> 32) + hi_hi, (cross << 32) | (lo_lo & 0xffffffffu)};
+#endif
+}
+
+constexpr int count_leading_zeros(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    for (; !(x >> 63); x <<= 1)
+        ++n;
+    return n;
+#endif
+}
+
+/* IEEE binary formats with a fast path: float and double. */
+template <typename T, typename = void>
+struct binary_format {
+    static constexpr bool supported = false;
+};
+
+template <typename T>
+struct binary_format<T, std::enable_if_t<std::numeric_limits<T>::is_iec559 &&
+                                         (std::numeric_limits<T>::digits == 24 ||
+                                          std::numeric_limits<T>::digits == 53)>> {
+    static constexpr bool supported = true;
+    static constexpr bool single = std::numeric_limits<T>::digits == 24;
+    using bits_type = std::conditional_t<single, uint32_t, uint64_t>;
+
+    static constexpr int mantissa_bits = std::numeric_limits<T>::digits - 1;
+    static constexpr int minimum_exponent = single ? -127 : -1023;
+    static constexpr int infinite_power = single ? 0xff : 0x7ff;
+    static constexpr int smallest_power_of_ten = single ? -64 : -342;
+    static constexpr int largest_power_of_ten = single ? 38 : 308;
+    static constexpr int min_exponent_round_to_even = single ? -17 : -4;
+    static constexpr int max_exponent_round_to_even = single ? 10 : 23;
+    /* w * 10^q is exact in T as long as w < 2^(mantissa_bits + 1) and |q| is at most this */
+    static constexpr int max_exact_power_of_ten = single ? 10 : 22;
+};
+
+/* w * 10^q as IEEE fields: the biased exponent, power2, and the mantissa without its
+ * leading bit. Eisel-Lemire: one or two 64x128 bit multiplications by a
+ * truncated power of five, exact for every w of at most 19 digits. Zero means
+ * underflow, infinite_power means overflow. */
+template <typename T>
+constexpr std::pair<int, uint64_t> eisel_lemire(uint64_t w, int64_t q) noexcept {
+    using format = binary_format<T>;
+    if (q < format::smallest_power_of_ten)
+        return {0, 0};
+    if (q > format::largest_power_of_ten)
+        return {format::infinite_power, 0};
+
+    int const lz = count_leading_zeros(w);
+    w <<= lz;
+
+    auto const index = 2 * static_cast<size_t>(q - powers_of_five::smallest);
+    auto product = multiply_full(w, powers_of_five::table[index]);
+    constexpr uint64_t precision_mask = ~uint64_t(0) >> (format::mantissa_bits + 3);
+    if ((product.high & precision_mask) == precision_mask) {
+        auto const second = multiply_full(w, powers_of_five::table[index + 1]);
+        product.low += second.high;
+        product.high += second.high > product.low;
+    }
+
+    int const upper_bit = static_cast<int>(product.high >> 63);
+    int const shift = upper_bit + 64 - format::mantissa_bits - 3;
+    uint64_t mantissa = product.high >> shift;
+    int power2 = static_cast<int>(((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz -
+                 format::minimum_exponent;
+
+    if (power2 <= 0) { /* subnormal */
+        if (-power2 + 1 >= 64)
+            return {0, 0};
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        return {mantissa < (uint64_t(1) << format::mantissa_bits) ? 0 : 1, mantissa};
+    }
+
+    /* exactly halfway: round to even rather than up */
+    if (product.low <= 1 && q >= format::min_exponent_round_to_even &&
+        q <= format::max_exponent_round_to_even && (mantissa & 3) == 1 &&
+        (mantissa << shift) == product.high)
+        mantissa &= ~uint64_t(1);
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (uint64_t(2) << format::mantissa_bits)) {
+        mantissa = uint64_t(1) << format::mantissa_bits;
+        ++power2;
+    }
+    mantissa &= ~(uint64_t(1) << format::mantissa_bits);
+    return {std::min(power2, format::infinite_power), mantissa};
+}
+
+/* the correctly rounded value of a literal for float and double, without the big
+ * decimal when it has at most 19 significant digits (or when more of them cannot
+ * change the result). first is false if that does not
+ * settle it. */
+template <typename T>
+constexpr std::pair<bool, std::optional<T>> fast_float(float_literal const &lit) noexcept {
+    using format = binary_format<T>;
+
+    uint64_t const w = lit.significand;
+    int64_t const q = lit.scale;
+    bool const truncated = lit.truncated;
+
+    auto const sign = [&](T x) { return lit.negative ? -x : x; };
+    if (w == 0)
+        return {true, sign(T(0))};
+
+#if FLT_EVAL_METHOD == 0
+    /* Clinger: both w and 10^|q| are exact, so one correctly rounded operation is enough. */
+    if (!truncated && w >> (format::mantissa_bits + 1) == 0 &&
+        q >= -format::max_exact_power_of_ten && q <= format::max_exact_power_of_ten) {
+        T power = 1;
+        for (int i = 0; i < (q < 0 ? -q : q); ++i)
+            power *= 10;
+        return {true, sign(q < 0 ? T(w) / power : T(w) * power)};
+    }
+#endif
+
+    auto const fields = eisel_lemire<T>(w, q);
+    /* the dropped digits lie between w and w + 1 */
+    if (truncated && fields != eisel_lemire<T>(w + 1, q))
+        return {false, std::nullopt};
+
+    auto const [power2, mantissa] = fields;
+    if ((power2 == 0 && mantissa == 0) || power2 == format::infinite_power)
+        return {true, std::nullopt};
+
+    if (!is_constant_evaluated()) {
+        auto const bits = static_cast<typename format::bits_type>(
+            uint64_t{lit.negative} << (format::mantissa_bits + (format::single ? 8 : 11)) |
+            uint64_t(power2) << format::mantissa_bits | mantissa);
+        T value{};
+        std::memcpy(&value, &bits, sizeof value);
+        return {true, value};
+    }
+    auto const exponent =
+        std::max(power2, 1) + format::minimum_exponent - format::mantissa_bits;
+    auto const significand =
+        power2 ? mantissa | uint64_t(1) << format::mantissa_bits : mantissa;
+    return {true, sign(scale2(static_cast<T>(significand), exponent))};
+}
+
+template <typename T>
+constexpr std::optional<T> parse_float(char const *str, char const *str_end) noexcept {
+    auto const lit = scan_float(str, str_end);
+    if (!lit)
+        return std::nullopt;
+
+    switch (lit->kind) {
+    case float_literal::infinity:
+        return lit->negative ? -std::numeric_limits<T>::infinity()
+                             : std::numeric_limits<T>::infinity();
+    case float_literal::not_a_number:
+        return lit->negative ? -std::numeric_limits<T>::quiet_NaN()
+                             : std::numeric_limits<T>::quiet_NaN();
+    default:
+        break;
+    }
+
+    if constexpr (binary_format<T>::supported) {
+        auto const [settled, value] = fast_float<T>(*lit);
+        return settled ? value : decimal(*lit).to_float<T>();
+    } else if constexpr (std::numeric_limits<T>::digits > 64) {
+        /* no exact constant-evaluated path for wider types: go through double. */
+        auto const d = decimal(*lit).to_float<double>();
+        return d ? std::optional<T>{*d} : std::nullopt;
+    } else {
+        return decimal(*lit).to_float<T>();
+    }
+}
+
+/* Trick to parse floating point types using from_chars when available.
+ * Otherwise float and double go through parse_float, and long double through
+ * strtold on a null-terminated copy (parse_float past its size). Integers always
+ * go through parse_integer. */
+template <typename T, typename = void>
+struct str_to_num {
+    static constexpr std::optional<T> get(char const *str, char const *str_end) noexcept {
+        auto const n = static_cast<size_t>(str_end - str);
+        char buffer[128] = {};
+        if (is_constant_evaluated() || binary_format<T>::supported || n >= sizeof buffer)
+            return parse_float<T>(str, str_end);
+
+        /* the forms strtold accepts but from_chars does not */
+        if (n == 0 || std::isspace(static_cast<unsigned char>(*str)) || *str == '+' ||
+            (n > 2 && std::tolower(str[1]) == 'x'))
+            return std::nullopt;
+
+        std::memcpy(buffer, str, n);
+        char *p = nullptr;
+        errno = 0;
+        auto const result = static_cast<T>(std::strtold(buffer, &p));
+        return (!errno && p == buffer + n) ? std::optional<T>{result} : std::nullopt;
+    }
+};
+
+/* specialization available if the corresponding from_chars overload is present. */
+template <typename T>
+struct str_to_num<
+    T, std::void_t<std::enable_if_t<std::is_floating_point_v<T>>,
+                   decltype(std::from_chars(nullptr, nullptr, std::declval<T &>()))>> {
+    static constexpr std::optional<T> get(char const *str, char const *str_end) noexcept {
+        if (is_constant_evaluated())
+            return parse_float<T>(str, str_end);
+
+        T result{};
+        auto [p, ec] = std::from_chars(str, str_end, result);
+        return (ec == std::errc() && p == str_end) ? std::optional<T>{result} : std::nullopt;
+    }
+};
+
+template <typename T>
+struct str_to_num<T, std::enable_if_t<std::is_integral_v<T>>> {
+    static constexpr std::optional<T> get(char const *str, char const *str_end) noexcept {
+        return parse_integer<T>(str, str_end);
+    }
+};
+
+/* Quantities with a unit, as in 4GiB or 250ms. A single scan accumulates the
+ * decimal digits and stops at the first other character, where the suffix
+ * starts: it is matched against the units from there, without a second pass
+ * over the digits. */
+struct counted {
+    uint64_t count;
+    std::string_view suffix;
+};
+
+constexpr std::optional<counted> parse_count(char const *str,
+                                             char const *str_end) noexcept {
+    constexpr auto max = std::numeric_limits<uint64_t>::max();
+
+    if (str == str_end || !is_digit(*str))
+        return std::nullopt;
+
+    uint64_t count = 0;
+    for (; str != str_end && is_digit(*str); ++str) {
+        auto const d = static_cast<unsigned>(*str - '0');
+        if (count > (max - d) / 10)
+            return std::nullopt;
+        count = count * 10 + d;
+    }
+    return counted{count, {str, static_cast<size_t>(str_end - str)}};
+}
+
+/* the bytes in a unit: B (or none), K (or k), M, G, T in powers of 1000,
+ * optionally followed by B, or KiB, MiB, GiB, TiB in powers of 1024. 0 if
+ * unknown. */
+constexpr uint64_t byte_unit(std::string_view suffix) noexcept {
+    if (suffix.empty() || suffix == "B")
+        return 1;
+
+    auto const prefix = suffix[0];
+    unsigned power = 0;
+    switch (prefix) {
+    case 'k':
+    case 'K':
+        power = 1;
+        break;
+    case 'M':
+        power = 2;
+        break;
+    case 'G':
+        power = 3;
+        break;
+    case 'T':
+        power = 4;
+        break;
+    default:
+        return 0;
+    }
+
+    suffix.remove_prefix(1);
+    if (suffix.empty() || suffix == "B") {
+        uint64_t unit = 1;
+        while (power--)
+            unit *= 1000;
+        return unit;
+    }
+    return (suffix == "iB" && prefix != 'k') ? uint64_t{1} << (10 * power) : 0;
+}
+
+/* count units of Unit as a duration<Rep, Period>, if it is exactly one. */
+template <typename Rep, typename Period, typename Unit>
+constexpr std::optional<std::chrono::duration<Rep, Period>>
+as_duration(uint64_t count) noexcept {
+    using duration = std::chrono::duration<Rep, Period>;
+    using factor = std::ratio_divide<Unit, Period>;
+    constexpr auto num = static_cast<uint64_t>(factor::num);
+    constexpr auto den = static_cast<uint64_t>(factor::den);
+
+    if constexpr (std::is_floating_point_v<Rep>) {
+        return duration(static_cast<Rep>(count) * num / den);
+    } else {
+        constexpr auto max = static_cast<uint64_t>(std::numeric_limits<Rep>::max());
+        if (count % den || count / den > max / num)
+            return std::nullopt;
+        return duration(static_cast<Rep>(count / den * num));
+    }
+}
+
+template <typename T>
+constexpr bool is_tuple = false;
+
+template <typename... Ts>
+constexpr bool is_tuple<std::tuple<Ts...>> = true;
+
+template <typename T, size_t N>
+constexpr bool is_tuple<std::array<T, N>> = true;
+
+template <typename M>
+struct member_pointer;
+
+template <typename S, typename T>
+struct member_pointer<T S::*> {
+    using object_type = S;
+    using value_type = T;
+};
+
+/* deliberately not constexpr: reaching it in a constant expression is an error. */
+inline void unknown_argument_name() noexcept {}
+inline void unknown_command_name() noexcept {}
+
+/* smallest unsigned type able to hold every index in [0, N]. */
+template <size_t N>
+using index_t = std::conditional_t<(N < 0xff), uint8_t,
+                                   std::conditional_t<(N < 0xffff), uint16_t, uint32_t>>;
+
+constexpr size_t ceil_pow2(size_t n) noexcept {
+    size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+/* FNV-1a. Names are short, so this is cheaper than anything fancier. */
+constexpr uint64_t hash(std::string_view s) noexcept {
+    uint64_t h = 0xcbf29ce484222325u;
+    for (char c : s)
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3u;
+    return h;
+}
+
+/* scrambles a name hash with a per-bucket seed (murmur3's finalizer). */
+constexpr uint64_t remix(uint64_t h, uint64_t seed) noexcept {
+    h ^= seed * 0x9e3779b97f4a7c15u;
+    h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdu;
+    h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53u;
+    return h ^ (h >> 33);
+}
+
+/* Hash-and-displace perfect hash over up to N names, built at construction.
+ * Every name lands in its own slot of a table with load factor <= 1/2, so a
+ * lookup is one hash of the word, two table reads and a single comparison.
+ * The names themselves are not stored; callers pass a function mapping an
+ * index back to its name. Should the construction fail (repeated names), the
+ * table falls back to a linear scan that finds the first match. */
+template <size_t N>
+struct perfect_hash {
+    using index_type = index_t<N>;
+    static constexpr size_t n_buckets = N ? N : 1;
+    static constexpr size_t n_slots = ceil_pow2(2 * n_buckets);
+    static constexpr size_t max_seed = 0xffff;
+
+    size_t n = 0;
+    bool perfect = true;
+    std::array<uint16_t, n_buckets> seeds{};
+    std::array<index_type, n_slots> slots{};
+
+    constexpr perfect_hash() noexcept {
+        for (auto &s : slots)
+            s = N;
+    }
+
+    template <typename KeyFn>
+    constexpr perfect_hash(size_t n_keys, KeyFn &&key) noexcept : perfect_hash() {
+        n = n_keys;
+
+        /* bucket the keys by hash, laid out contiguously per bucket. */
+        std::array<uint64_t, N ? N : 1> hashes{};
+        std::array<size_t, n_buckets + 1> start{};
+        std::array<size_t, N ? N : 1> members{};
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = hash(key(i));
+            ++start[hashes[i] % n_buckets + 1];
+        }
+        for (size_t b = 0; b < n_buckets; ++b)
+            start[b + 1] += start[b];
+        {
+            auto fill = start;
+            for (size_t i = 0; i < n; ++i)
+                members[fill[hashes[i] % n_buckets]++] = i;
+        }
+
+        /* place the largest buckets first, while the table is still empty. */
+        std::array<size_t, n_buckets> order{};
+        {
+            std::array<size_t, (N ? N : 1) + 2> by_size{};
+            for (size_t b = 0; b < n_buckets; ++b)
+                ++by_size[n - (start[b + 1] - start[b]) + 1];
+            for (size_t s = 0; s <= n; ++s)
+                by_size[s + 1] += by_size[s];
+            for (size_t b = 0; b < n_buckets; ++b)
+                order[by_size[n - (start[b + 1] - start[b])]++] = b;
+        }
+
+        for (auto b : order) {
+            auto const first = start[b], last = start[b + 1];
+            if (first == last)
+                break;
+
+            for (auto i = first; i < last; ++i)
+                for (auto j = i + 1; j < last; ++j)
+                    if (hashes[members[i]] == hashes[members[j]]) {
+                        perfect = false;
+                        return;
+                    }
+
+            size_t seed = 0;
+            for (; seed <= max_seed; ++seed) {
+                auto placed = first;
+                for (; placed < last; ++placed) {
+                    auto const h = hashes[members[placed]];
+                    auto &slot = slots[remix(h, seed) & (n_slots - 1)];
+                    if (slot != N)
+                        break;
+                    slot = static_cast<index_type>(members[placed]);
+                }
+                if (placed == last)
+                    break;
+                for (auto i = first; i < placed; ++i)
+                    slots[remix(hashes[members[i]], seed) & (n_slots - 1)] = N;
+            }
+            if (seed > max_seed) {
+                perfect = false;
+                return;
+            }
+            seeds[b] = static_cast<uint16_t>(seed);
+        }
+    }
+
+    /* index of the key equal to word, or N if there is none. */
+    template <typename KeyFn>
+    constexpr size_t find(std::string_view word, KeyFn &&key) const noexcept {
+        if (!perfect) {
+            size_t i = 0;
+            while (i < n && key(i) != word)
+                ++i;
+            return i < n ? i : N;
+        }
+        auto const h = hash(word);
+        size_t const i = slots[remix(h, seeds[h % n_buckets]) & (n_slots - 1)];
+        return (i < N && key(i) == word) ? i : N;
+    }
+};
+
+/* Whether the n <= N keys are all different. Their indices are heapsorted by
+ * key (std::sort is not constexpr before C++20), so neighbours are compared. */
+template <size_t N, typename KeyFn>
+constexpr bool all_distinct(size_t n, KeyFn &&key) noexcept {
+    std::array<size_t, N ? N : 1> order{};
+    for (size_t i = 0; i < n; ++i)
+        order[i] = i;
+
+    auto const swap = [&](size_t a, size_t b) {
+        auto const t = order[a];
+        order[a] = order[b];
+        order[b] = t;
+    };
+    auto const sift_down = [&](size_t root, size_t end) {
+        for (size_t child = 2 * root + 1; child < end; child = 2 * root + 1) {
+            if (child + 1 < end && key(order[child]) < key(order[child + 1]))
+                ++child;
+            if (!(key(order[root]) < key(order[child])))
+                return;
+            swap(root, child);
+            root = child;
+        }
+    };
+
+    for (size_t i = n / 2; i-- > 0;)
+        sift_down(i, n);
+    for (size_t end = n; end > 1; --end) {
+        swap(0, end - 1);
+        sift_down(0, end - 1);
+    }
+    for (size_t i = 1; i < n; ++i)
+        if (key(order[i - 1]) == key(order[i]))
+            return false;
+    return true;
+}
+} // namespace detail
+
+/* Unwrappers convert the argc words at argv into a T. argv is either an argv
+ * (null-terminated words) or points to std::string_views (words split from a
+ * string, see token_buffer), so that each unwrapper works with both. */
+template <typename T, typename = void>
+struct unwrapper {
+    /* only argv words are null-terminated: char const * from string_views fails. */
+    template <typename Words>
+    static constexpr std::optional<T> get(int argc, Words argv) noexcept {
+        if constexpr (std::is_constructible_v<T, decltype(argv[0])>)
+            return (argc == 1) ? std::optional<T>{argv[0]} : std::nullopt;
+        else
+            return std::nullopt;
+    }
+};
+
+template <typename T>
+struct unwrapper<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+    template <typename Words>
+    static constexpr std::optional<T> get(int argc, Words argv) noexcept {
+        if (argc != 1)
+            return std::nullopt;
+        auto val = std::string_view(argv[0]);
+        return detail::str_to_num<T>::get(val.data(), val.data() + val.size());
+    }
+};
+
+template <typename T>
+struct unwrapper<T, std::enable_if_t<detail::is_tuple<T>>> {
+    template <typename Words, size_t... I>
+    static constexpr std::optional<T> get_tuple(Words argv,
+                                                std::index_sequence<I...>) noexcept {
+        auto opts =
+            std::make_tuple(unwrapper<std::tuple_element_t<I, T>>::get(1, argv + I)...);
+        bool ok = (!!std::get<I>(opts) && ...);
+
+        return ok ? std::optional<T>{{*std::get<I>(opts)...}} : std::nullopt;
+    }
+
+    template <typename Words>
+    static constexpr std::optional<T> get(int argc, Words argv) noexcept {
+        return (static_cast<size_t>(argc) == std::tuple_size_v<T>)
+                   ? get_tuple(argv, std::make_index_sequence<std::tuple_size_v<T>>{})
+                   : std::nullopt;
+    }
+};
+
+/* The names of the values of an enum, which give it an unwrapper. Specialize it
+ * with a table of name and value pairs:
+ *
+ *     enum class mode { fast, safe, audit };
+ *
+ *     namespace carp {
+ *     template <>
+ *     struct enum_names<mode> {
+ *         static constexpr std::pair<std::string_view, mode> values[] = {
+ *             {"fast", mode::fast}, {"safe", mode::safe}, {"audit", mode::audit}};
+ *     };
+ *     } // namespace carp
+ *
+ * so that args["--mode"] | mode::safe takes --mode=audit. */
+template <typename E>
+struct enum_names;
+
+namespace detail {
+template <typename E, typename = void>
+constexpr bool has_enum_names = false;
+
+template <typename E>
+constexpr bool has_enum_names<E, std::void_t<decltype(enum_names<E>::values)>> = true;
+
+template <typename E>
+constexpr std::string_view enum_name(size_t i) noexcept {
+    return enum_names<E>::values[i].first;
+}
+
+template <typename E>
+inline constexpr size_t n_enum_names = std::size(enum_names<E>::values);
+
+/* built once per enum, at compile time. */
+template <typename E>
+inline constexpr auto enum_lookup =
+    perfect_hash<n_enum_names<E>>(n_enum_names<E>, enum_name<E>);
+} // namespace detail
+
+/* one hash and one comparison resolve any name. */
+template <typename T>
+struct unwrapper<T, std::enable_if_t<detail::has_enum_names<T>>> {
+    static_assert(detail::enum_lookup<T>.perfect ||
+                      detail::all_distinct<detail::n_enum_names<T>>(
+                          detail::n_enum_names<T>, detail::enum_name<T>),
+                  "carp: an enum name is repeated");
+
+    template <typename Words>
+    static constexpr std::optional<T> get(int argc, Words argv) noexcept {
+        if (argc != 1)
+            return std::nullopt;
+        auto const i = detail::enum_lookup<T>.find(std::string_view(argv[0]),
+                                                    detail::enum_name<T>);
+        if (i == detail::n_enum_names<T>)
+            return std::nullopt;
+        return enum_names<T>::values[i].second;
+    }
+};
+
+/* A number of bytes, unwrapped from a count and a unit as in 4GiB, 512K or
+ * 100MB (see detail::byte_unit). Counts larger than 64 bits fail. */
+struct byte_size {
+    uint64_t bytes = 0;
+
+    constexpr bool operator==(byte_size o) const noexcept { return bytes == o.bytes; }
+    constexpr bool operator!=(byte_size o) const noexcept { return bytes != o.bytes; }
+};
+
+template <>
+struct unwrapper<byte_size> {
+    template <typename Words>
+    static constexpr std::optional<byte_size> get(int argc, Words argv) noexcept {
+        if (argc != 1)
+            return std::nullopt;
+        auto const val = std::string_view(argv[0]);
+        auto const q = detail::parse_count(val.data(), val.data() + val.size());
+        if (!q)
+            return std::nullopt;
+        auto const unit = detail::byte_unit(q->suffix);
+        if (!unit || q->count > std::numeric_limits<uint64_t>::max() / unit)
+            return std::nullopt;
+        return byte_size{q->count * unit};
+    }
+};
+
+/* A count and a unit, one of ns, us, ms, s, m and h, as in 250ms. The unit is
+ * required, and the value must fit the duration exactly: 2000us is a
+ * std::chrono::milliseconds, but not 2001us. */
+template <typename Rep, typename Period>
+struct unwrapper<std::chrono::duration<Rep, Period>> {
+    using duration = std::chrono::duration<Rep, Period>;
+
+    template <typename Words>
+    static constexpr std::optional<duration> get(int argc, Words argv) noexcept {
+        using detail::as_duration;
+        if (argc != 1)
+            return std::nullopt;
+        auto const val = std::string_view(argv[0]);
+        auto const q = detail::parse_count(val.data(), val.data() + val.size());
+        if (!q)
+            return std::nullopt;
+
+        auto const s = q->suffix;
+        if (s == "ns")
+            return as_duration<Rep, Period, std::nano>(q->count);
+        if (s == "us")
+            return as_duration<Rep, Period, std::micro>(q->count);
+        if (s == "ms")
+            return as_duration<Rep, Period, std::milli>(q->count);
+        if (s == "s")
+            return as_duration<Rep, Period, std::ratio<1>>(q->count);
+        if (s == "m")
+            return as_duration<Rep, Period, std::ratio<60>>(q->count);
+        if (s == "h")
+            return as_duration<Rep, Period, std::ratio<3600>>(q->count);
+        return std::nullopt;
+    }
+};
+
+namespace detail {
+constexpr int count_trailing_zeros(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    int n = 0;
+    for (; !(x & 1); x >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+/* the first c in [str, str_end), or str_end. Long strings are searched sixteen
+ * characters at a time with SSE2. */
+constexpr char const *find_char(char const *str, char const *str_end, char c) noexcept {
+#if defined(__SSE2__)
+    if (!is_constant_evaluated()) {
+        auto const needle = _mm_set1_epi8(c);
+        for (; str_end - str >= 16; str += 16) {
+            auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(str));
+            if (auto const hits = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))
+                return str + count_trailing_zeros(static_cast<uint32_t>(hits));
+        }
+    }
+#endif
+    while (str != str_end && *str != c)
+        ++str;
+    return str;
+}
+
+template <typename T, typename Out>
+constexpr bool split_item(std::string_view item, Out &out) noexcept {
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        if (auto const dash = item.find('-', 1); dash != std::string_view::npos) {
+            std::string_view const bounds[] = {item.substr(0, dash),
+                                               item.substr(dash + 1)};
+            auto const first = unwrapper<T>::get(1, bounds);
+            auto const last = unwrapper<T>::get(1, bounds + 1);
+            if (!first || !last || *last < *first)
+                return false;
+            for (auto value = *first;; ++value) {
+                if (!out(value))
+                    return false;
+                if (value == *last)
+                    return true;
+            }
+        }
+    }
+    auto const value = unwrapper<T>::get(1, &item);
+    return value && out(*value);
+}
+
+/* Splits word on delim and passes each element, unwrapped as a T, to out. The
+ * elements are views of the word. An integral element may be a range, as in
+ * 16-23, which passes each value in it. An empty word has no elements. false if
+ * an element does not convert or out returns false. */
+template <typename T, typename Out>
+constexpr bool split_list(std::string_view word, char delim, Out &&out) noexcept {
+    if (word.empty())
+        return true;
+
+    auto str = word.data();
+    auto const str_end = str + word.size();
+    for (;;) {
+        auto const next = find_char(str, str_end, delim);
+        std::string_view const item(str, static_cast<size_t>(next - str));
+
+        if (!split_item<T>(item, out))
+            return false;
+
+        if (next == str_end)
+            return true;
+        str = next + 1;
+    }
+}
+} // namespace detail
+
+/* Up to K values given as one word and split on Delim, as in --cpus=0-7,16-23
+ * or --weights=0.5,0.25,0.25 (see detail::split_list). More fail. To split
+ * into storage of the caller's instead, see parsed_args::arg_proxy::split. */
+template <typename T, size_t K, char Delim = ','>
+struct list {
+    std::array<T, K> values{};
+    size_t size = 0;
+
+    constexpr T const *begin() const noexcept { return values.data(); }
+    constexpr T const *end() const noexcept { return values.data() + size; }
+    constexpr T const &operator[](size_t i) const noexcept { return values[i]; }
+};
+
+template <typename T, size_t K, char Delim>
+struct unwrapper<list<T, K, Delim>> {
+    template <typename Words>
+    static constexpr std::optional<list<T, K, Delim>> get(int argc, Words argv) noexcept {
+        if (argc != 1)
+            return std::nullopt;
+        list<T, K, Delim> res;
+        bool const ok = detail::split_list<T>(std::string_view(argv[0]), Delim,
+                                              [&res](T const &value) {
+                                                  if (res.size == K)
+                                                      return false;
+                                                  res.values[res.size++] = value;
+                                                  return true;
+                                              });
+        return ok ? std::optional<list<T, K, Delim>>{res} : std::nullopt;
+    }
+};
+
+namespace detail {
+enum : uint8_t { shell_plain, shell_space, shell_quoting };
+
+/* how token_buffer treats each character. */
+inline constexpr auto shell_char_classes = [] {
+    std::array<uint8_t, 256> classes{};
+    for (unsigned char c : {' ', '\t', '\n', '\r', '\v', '\f', '\0'})
+        classes[c] = shell_space;
+    for (unsigned char c : {'\'', '"', '\\'})
+        classes[c] = shell_quoting;
+    return classes;
+}();
+
+/* the contents of the file named by the null-terminated path. A regular file
+ * with a size is mapped read-only until unmap_file, and mapped is set; anything
+ * else (a pipe, an empty file or a /proc file, whose size reads as 0), or any
+ * file without mmap, is read into buf, failing past capacity. */
+inline std::optional<std::string_view> load_file(char const *path, char *buf,
+                                                 size_t capacity, bool &mapped) noexcept {
+    mapped = false;
+#if CARP_HAS_MMAP
+    int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return std::nullopt;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        auto const size = static_cast<size_t>(st.st_size);
+        void *const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            return std::nullopt;
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+        mapped = true;
+        return std::string_view(static_cast<char const *>(mapping), size);
+    }
+    std::FILE *const f = ::fdopen(fd, "rb");
+    if (!f) {
+        ::close(fd);
+        return std::nullopt;
+    }
+#else
+    std::FILE *const f = std::fopen(path, "rb");
+    if (!f)
+        return std::nullopt;
+#endif
+    auto const n = std::fread(buf, 1, capacity, f);
+    bool const ok = !std::ferror(f) && std::fgetc(f) == EOF;
+    std::fclose(f);
+    if (!ok)
+        return std::nullopt;
+    return std::string_view(buf, n);
+}
+
+#if CARP_HAS_MMAP
+inline void unmap_file(std::string_view file) noexcept {
+    if (!file.empty())
+        ::munmap(const_cast<char *>(file.data()), file.size());
+}
+#endif
+} // namespace detail
+
+/* selects splitting on '\0' alone, for token_buffer::split. */
+struct nul_delimited_t {
+    explicit constexpr nul_delimited_t() noexcept = default;
+};
+inline constexpr nul_delimited_t nul_delimited{};
+
+/* Caller-owned storage for the words of a command line string, as split by
+ * split() with POSIX shell-like rules: words are separated by whitespace (or
+ * '\0'), '...' quotes everything, "..." everything but \", \\, \$, \` and
+ * \newline, and a backslash elsewhere quotes the next character. There is no
+ * expansion of any kind. Words that were never quoted, as in
+ * /proc/<pid>/cmdline, are split with nul_delimited instead.
+ * Words are views of the split string itself, so it must outlive them. Only the
+ * words that quoting or escapes break into pieces are joined in chars. Nor are
+ * they null-terminated: parsed, unwrap them as std::string_view (| ""sv), as a
+ * char const * default (| "none") only takes argv words and yields nullopt. */
+template <size_t max_words, size_t max_chars = 256>
+class token_buffer {
+public:
+    /* false if cmdline has an unterminated quote, a trailing backslash, or more
+     * words or joined characters than fit. */
+    constexpr bool split(std::string_view cmdline) noexcept {
+        n_words = n_chars = 0;
+        return split_into(cmdline, [this](std::string_view w) { return push(w); });
+    }
+
+    /* splits words that each end with a '\0' (the last one may not), taking the
+     * rest literally: blanks, quotes and backslashes stay, and empty words are
+     * kept. Every word is a view of text. false if there are more than fit. */
+    constexpr bool split(std::string_view text, nul_delimited_t) noexcept {
+        n_words = n_chars = 0;
+        char const *it = text.data(), *const end = it + text.size();
+        while (it != end) {
+            auto const word_end = detail::find_char(it, end, '\0');
+            if (!push({it, static_cast<size_t>(word_end - it)}))
+                return false;
+            it = word_end == end ? end : word_end + 1;
+        }
+        return true;
+    }
+
+    constexpr size_t size() const noexcept { return n_words; }
+    constexpr std::string_view const *data() const noexcept { return words.data(); }
+    constexpr std::string_view const *begin() const noexcept { return words.data(); }
+    constexpr std::string_view const *end() const noexcept { return words.data() + n_words; }
+    constexpr std::string_view operator[](size_t i) const noexcept { return words[i]; }
+
+protected:
+    constexpr bool push(std::string_view word) noexcept {
+        if (n_words == max_words)
+            return false;
+        words[n_words++] = word;
+        return true;
+    }
+
+    /* passes each word of text to emit, stopping if it returns false. */
+    template <typename Emit>
+    constexpr bool split_into(std::string_view text, Emit &&emit) noexcept {
+        char const *c = text.data(), *const end = c + text.size();
+
+        while (true) {
+            while (c != end && is_space(*c))
+                ++c;
+            if (c == end)
+                return true;
+
+            word w{this};
+            while (c != end && !is_space(*c)) {
+                if (*c == '\'') {
+                    auto const piece = ++c;
+                    while (c != end && *c != '\'')
+                        ++c;
+                    if (c == end)
+                        return false;
+                    w.append(piece, c++);
+                } else if (*c == '"') {
+                    for (++c; c != end && *c != '"'; ++c) {
+                        auto const piece = c;
+                        while (c != end && *c != '"' && *c != '\\')
+                            ++c;
+                        w.append(piece, c);
+                        if (c == end || *c == '"')
+                            break;
+                        if (++c == end)
+                            return false;
+                        if (*c != '"' && *c != '\\' && *c != '$' && *c != '`' && *c != '\n')
+                            w.append(c - 1, c + 1); /* the backslash stays */
+                        else if (*c != '\n')
+                            w.append(c, c + 1);
+                    }
+                    if (c == end)
+                        return false;
+                    ++c;
+                } else if (*c == '\\') {
+                    if (++c == end)
+                        return false;
+                    if (*c != '\n')
+                        w.append(c, c + 1);
+                    ++c;
+                } else {
+                    auto const piece = c;
+                    while (c != end && char_class(*c) == plain)
+                        ++c;
+                    w.append(piece, c);
+                }
+            }
+            if (!w.ok || !emit(w.view()))
+                return false;
+        }
+    }
+
+    std::array<std::string_view, max_words> words{};
+    std::array<char, max_chars> chars{};
+    size_t n_words = 0, n_chars = 0;
+
+private:
+    static constexpr auto plain = detail::shell_plain, space = detail::shell_space;
+
+    static constexpr uint8_t char_class(char c) noexcept {
+        return detail::shell_char_classes[static_cast<unsigned char>(c)];
+    }
+
+    static constexpr bool is_space(char c) noexcept { return char_class(c) == space; }
+
+    /* a word being split: a single view of the string while it is one piece,
+     * then joined in chars. */
+    struct word {
+        token_buffer *buffer;
+        char const *first = nullptr, *last = nullptr;
+        size_t joined = npos; /* start in chars once joined */
+        bool ok = true;
+
+        static constexpr size_t npos = ~size_t(0);
+
+        constexpr void append(char const *from, char const *to) noexcept {
+            if (from == to)
+                return;
+            if (!first && joined == npos) {
+                first = from, last = to;
+            } else if (joined == npos && from == last) {
+                last = to;
+            } else {
+                if (joined == npos) {
+                    joined = buffer->n_chars;
+                    copy(first, last);
+                }
+                copy(from, to);
+            }
+        }
+
+        constexpr void copy(char const *from, char const *to) noexcept {
+            if (static_cast<size_t>(to - from) > max_chars - buffer->n_chars) {
+                ok = false;
+                return;
+            }
+            for (; from != to; ++from)
+                buffer->chars[buffer->n_chars++] = *from;
+        }
+
+        constexpr std::string_view view() const noexcept {
+            if (joined == npos)
+                return first ? std::string_view(first, static_cast<size_t>(last - first))
+                             : std::string_view();
+            return {buffer->chars.data() + joined, buffer->n_chars - joined};
+        }
+    };
+};
+
+/* Storage for parse() with response files: the words of argv, where each @path
+ * word is replaced by the words of that file, split as token_buffer does (and
+ * expanded in turn, up to max_depth files deep). Regular files are mapped
+ * read-only and their words are views of the mapping, until the arena is
+ * destroyed or reused; pipes, and every file where mmap is not available (see
+ * CARP_POSIX), are read into chars instead. Every word is then a view, to be
+ * unwrapped as std::string_view rather than char const * (see token_buffer).
+ * An arena is large: allocate it once, statically or on the heap. */
+template <size_t max_words, size_t max_chars = 4096, size_t max_files = 16>
+class response_arena : public token_buffer<max_words, max_chars> {
+public:
+    static constexpr int max_depth = 16;
+
+    response_arena() noexcept = default;
+    response_arena(response_arena const &) = delete;
+    response_arena &operator=(response_arena const &) = delete;
+    ~response_arena() { release(); }
+
+    /* false if a file cannot be read, or its words do not fit. */
+    bool expand(int argc, char const *const *argv) noexcept {
+        release();
+        this->n_words = this->n_chars = 0;
+        for (int i = 0; i < argc; ++i) {
+            auto const word = std::string_view(argv[i]);
+            if (!(i == 0 ? this->push(word) : add(word, 0)))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    bool add(std::string_view word, int depth) noexcept {
+        if (word.size() < 2 || word[0] != '@')
+            return this->push(word);
+        if (depth == max_depth || n_files == max_files)
+            return false;
+
+        auto const text = read(word.substr(1));
+        return text && this->split_into(*text, [this, depth](std::string_view w) {
+            return add(w, depth + 1);
+        });
+    }
+
+    std::optional<std::string_view> read(std::string_view path) noexcept {
+        char name[4096];
+        if (path.size() >= sizeof name)
+            return std::nullopt;
+        std::memcpy(name, path.data(), path.size());
+        name[path.size()] = '\0';
+
+        bool mapped;
+        auto const start = this->n_chars;
+        auto const file = detail::load_file(name, this->chars.data() + start,
+                                            max_chars - start, mapped);
+        if (!file)
+            return std::nullopt;
+        if (!mapped)
+            this->n_chars += file->size();
+        files[n_files++] = mapped ? *file : std::string_view();
+        return file;
+    }
+
+    void release() noexcept {
+#if CARP_HAS_MMAP
+        for (size_t i = 0; i < n_files; ++i)
+            detail::unmap_file(files[i]);
+#endif
+        n_files = 0;
+    }
+
+    std::string_view files[max_files];
+    size_t n_files = 0;
+};
+
+template <size_t N>
+class parser;
+
+/* A file of key = value lines that gives the switches missing from the command
+ * line (see parser::parse_config). A key is the name of a switch without its
+ * leading dashes, as threads for --threads or j for -j, and its values follow
+ * an '=', separated by blanks unless it takes only one:
+ *
+ *     # whole-line comments
+ *     threads = 8
+ *     name = primary east
+ *     size = 640 480
+ *     verbose
+ *
+ * A switch without values is given by its key alone or set to true, and not
+ * by false. A regular file is mapped into memory, and the values are views of
+ * it (up to max_values of them, on up to max_values lines) as long as the
+ * config_file lives. It is split into lines once, when opened or assigned. A pipe, or
+ * any file without mmap, is read into the config_file instead, up to
+ * max_chars. As in token_buffer, values are not null-terminated: a string
+ * unwraps as std::string_view, not through a char const * default. */
+template <size_t max_values = 256, size_t max_chars = 4096>
+class config_file {
+public:
+    config_file() noexcept = default;
+    config_file(config_file const &) = delete;
+    config_file &operator=(config_file const &) = delete;
+    ~config_file() { release(); }
+
+    /* false if the file cannot be read. */
+    bool open(std::string_view path) noexcept {
+        release();
+        char name[4096];
+        if (path.size() >= sizeof name)
+            return false;
+        std::memcpy(name, path.data(), path.size());
+        name[path.size()] = '\0';
+
+        auto const file = detail::load_file(name, chars.data(), max_chars, mapped);
+        text = file ? *file : std::string_view();
+        split();
+        return file.has_value();
+    }
+
+    /* the lines in text instead of a file, which must outlive the parsed_args. */
+    void assign(std::string_view lines) noexcept {
+        release();
+        text = lines;
+        split();
+    }
+
+    std::string_view contents() const noexcept { return text; }
+
+private:
+    template <size_t>
+    friend class parser;
+
+    void release() noexcept {
+#if CARP_HAS_MMAP
+        if (mapped)
+            detail::unmap_file(text);
+#endif
+        mapped = false;
+        text = {};
+        n_lines = n_words = n_values = 0;
+        complete = true;
+    }
+
+    /* a line with a key, whose values are words[first, first + count). */
+    struct line {
+        std::string_view key;
+        uint32_t first = 0;
+        uint16_t count = 0;
+        bool fits = true;
+    };
+
+    /* splits the lines of text once, so that parsing leaves the config_file as it
+     * is. The values of a line are split on blanks, and if there are several,
+     * they are first given whole, as one word for a switch that takes one. */
+    void split() noexcept {
+        auto const blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+        auto const trim = [&](std::string_view s) {
+            while (!s.empty() && blank(s.front()))
+                s.remove_prefix(1);
+            while (!s.empty() && blank(s.back()))
+                s.remove_suffix(1);
+            return s;
+        };
+
+        auto it = text.data();
+        auto const text_end = it + text.size();
+        while (it != text_end) {
+            auto const it_end = detail::find_char(it, text_end, '\n');
+            auto const entry = trim({it, static_cast<size_t>(it_end - it)});
+            it = it_end == text_end ? text_end : it_end + 1;
+            if (entry.empty() || entry[0] == '#')
+                continue;
+            if (n_lines == max_values) {
+                complete = false;
+                return;
+            }
+
+            auto const eq = entry.find('=');
+            auto &l = lines[n_lines++];
+            l = {trim(entry.substr(0, eq))};
+            auto values = eq == std::string_view::npos ? std::string_view()
+                                                       : trim(entry.substr(eq + 1));
+            auto const start = n_words, counted = n_values;
+            if (values.find_first_of(" \t\r") != std::string_view::npos) {
+                if (n_words == words.size()) {
+                    l.fits = false;
+                    continue;
+                }
+                words[n_words++] = values;
+            }
+            l.first = static_cast<uint32_t>(n_words);
+            while (!values.empty()) {
+                if (n_values == max_values || n_words == words.size()) {
+                    l.fits = false;
+                    n_words = start, n_values = counted;
+                    break;
+                }
+                size_t n = 0;
+                while (n < values.size() && !blank(values[n]))
+                    ++n;
+                words[n_words++] = values.substr(0, n);
+                ++n_values;
+                values = trim(values.substr(n));
+            }
+            l.count = static_cast<uint16_t>(n_values - counted);
+        }
+    }
+
+    std::string_view text;
+    bool mapped = false;
+    std::array<line, max_values> lines{};
+    /* each line with several values takes one more word */
+    std::array<std::string_view, max_values + (max_values + 1) / 2> words{};
+    size_t n_lines = 0, n_words = 0, n_values = 0;
+    bool complete = true; /* false if the lines did not fit */
+    std::array<char, max_chars> chars{};
+};
+
+/* marks an argument that can be given more than once, for arg. */
+struct repeat_t {
+    explicit constexpr repeat_t() noexcept = default;
+};
+inline constexpr repeat_t repeatable{};
+
+/* A switch if its name starts with '-', else a positional, filled in order.
+ * A switch taking one value also takes it after '=' (--threads=8), and a
+ * single-character one right after its name (-j8). A last positional named
+ * like "command..." is a tail, taking every word from its own on, switches
+ * included (see parser::parsed_args::rest). After a "--" word, every word is a
+ * positional. */
+struct arg {
+    std::string_view name;
+    std::string_view desc;
+
+    ptrdiff_t nargs = 1;
+    /* the environment variable that gives the value when the command line
+     * does not (see parser::parse_env). */
+    std::string_view env;
+    bool repeat = false;
+
+    constexpr arg() noexcept = default;
+    constexpr arg(std::string_view name, std::string_view desc, size_t nargs = 0,
+                  std::string_view env = {}) noexcept
+      : name(name), desc(desc), nargs(1 + nargs), env(env) {}
+    /* a switch that can be given more than once, as in -I a -I b or -v -v. */
+    constexpr arg(std::string_view name, std::string_view desc, size_t nargs,
+                  repeat_t, std::string_view env = {}) noexcept
+      : name(name), desc(desc), nargs(1 + nargs), env(env), repeat(true) {}
+};
+
+/* What is wrong with a table of arguments, as found by parser::validate. */
+enum class table_error {
+    none,
+    invalid_name,        /* empty, starting with a digit or holding a space */
+    ambiguous_name,      /* "--", a positional starting with '-' or a switch with '=' */
+    repeated_name,
+    too_many_values,     /* more than 0xfffe values */
+    repeated_positional, /* only switches repeat */
+    misplaced_tail,      /* a positional named "name..." that is not the last one */
+    bad_env,             /* an environment name with '=', or for several values */
+    repeated_env,
+};
+
+namespace detail {
+/* where the values of an occurrence of a repeatable argument are. */
+struct occurrence {
+    uint32_t offset = 0;
+    uint16_t count = 0;
+    uint8_t skip = 0;
+    uint32_t arg = 0;
+};
+} // namespace detail
+
+/* Caller-owned storage for every occurrence of the repeatable arguments of a
+ * command line, up to capacity in all (see parser::parse). */
+template <size_t capacity>
+class occurrences {
+public:
+    constexpr size_t size() const noexcept { return n; }
+
+private:
+    template <size_t>
+    friend class parser;
+
+    detail::occurrence list[capacity]{};
+    size_t n = 0;
+};
+
+/* binds an argument to Member, a pointer to a data member, for parser::bind. */
+template <auto Member>
+struct field {
+    using object_type = typename detail::member_pointer<decltype(Member)>::object_type;
+    using value_type = typename detail::member_pointer<decltype(Member)>::value_type;
+
+    std::string_view name;
+
+    constexpr field(std::string_view name) noexcept : name(name) {}
+};
+
+template <size_t N>
+class parser {
+private:
+    struct labeled_arg {
+        int argc = 0;
+        /* the values, in one of these */
+        char const *const *argv = nullptr;
+        std::string_view const *views = nullptr;
+        /* characters to skip at the start of the value, such as the NAME= of an
+         * environment entry. Only set for a single value. */
+        unsigned skip = 0;
+
+        template <typename Words>
+        static constexpr labeled_arg make(int argc, Words words) noexcept {
+            labeled_arg res{argc};
+            if constexpr (std::is_convertible_v<Words, std::string_view const *>)
+                res.views = words;
+            else
+                res.argv = words;
+            return res;
+        }
+
+        /* the position of the values in the words at base, which they come from. */
+        template <typename Words>
+        constexpr ptrdiff_t offset(Words base) const noexcept {
+            if constexpr (std::is_convertible_v<Words, std::string_view const *>)
+                return views - base;
+            else
+                return argv - base;
+        }
+
+        constexpr bool present() const noexcept { return argv || views; }
+
+        /* calls f(argc, words). A skipped value is a single word of its own, so
+         * its count is given as 1 for the compiler to see the bound. */
+        template <typename F>
+        constexpr decltype(auto) visit(F &&f) const noexcept {
+            if (skip) {
+                if (views) {
+                    std::string_view const value = views->substr(skip);
+                    return f(1, &value);
+                }
+                char const *const value = *argv + skip;
+                return f(1, &value);
+            }
+            return views ? f(argc, views) : f(argc, argv);
+        }
+    };
+
+public:
+    using arg = carp::arg;
+
+    /* Asserts the table is valid (see validate), and make_parser checks it at
+     * compile time. */
+    constexpr parser(arg const (&arguments)[N]) noexcept {
+        assert(validate(arguments) == table_error::none && "invalid table: see validate.");
+
+        size_t n = 0;
+        auto const place = [&](arg const &a) {
+            if (a.repeat)
+                repeated.set({n});
+            names[n] = a.name;
+            nargs[n] = static_cast<uint16_t>(a.nargs);
+            descs[n] = a.desc;
+            envs[n++] = a.env;
+        };
+        for (auto const &a : arguments) {
+            if (!is_switch(a.name))
+                place(a);
+        }
+        n_positionals = n;
+        if (n_positionals && is_tail(names[n_positionals - 1]))
+            tail = n_positionals - 1;
+        for (auto const &a : arguments) {
+            if (is_switch(a.name))
+                place(a);
+        }
+        n_switches = n - n_positionals;
+
+        lookup = detail::perfect_hash<N>(N, [this](size_t j) { return names[j]; });
+
+        for (auto &i : short_switches)
+            i = N;
+        for (size_t ai = n_positionals; ai < N; ++ai) {
+            if (names[ai].size() == 2)
+                short_switches[static_cast<unsigned char>(names[ai][1])] =
+                    static_cast<detail::index_t<N>>(ai);
+        }
+
+        for (size_t ai = 0; ai < N; ++ai) {
+            if (!envs[ai].empty())
+                env_args[n_env++] = static_cast<detail::index_t<N>>(ai);
+        }
+        env_lookup =
+            detail::perfect_hash<N>(n_env, [this](size_t j) { return env_name(j); });
+    }
+
+    /* The first problem with a table of arguments, in O(N log N). */
+    static constexpr table_error validate(arg const (&arguments)[N]) noexcept {
+        constexpr auto npos = std::string_view::npos;
+        std::array<std::string_view, N ? N : 1> env_names{};
+        size_t n_env_names = 0, last_positional = N, tail_at = N;
+
+        for (size_t i = 0; i < N; ++i) {
+            auto const &a = arguments[i];
+            bool const option = is_switch(a.name);
+            if (!is_valid(a.name))
+                return table_error::invalid_name;
+            if (a.name == "--" || (!option && a.name[0] == '-') ||
+                (option && a.name.find('=') != npos))
+                return table_error::ambiguous_name;
+            if (a.nargs < 1 || a.nargs > 0xffff)
+                return table_error::too_many_values;
+            if (a.repeat && !option)
+                return table_error::repeated_positional;
+            if (!a.env.empty()) {
+                if (a.env.find('=') != npos || a.nargs > 1 + option)
+                    return table_error::bad_env;
+                env_names[n_env_names++] = a.env;
+            }
+            if (!option) {
+                last_positional = i;
+                tail_at = is_tail(a.name) && tail_at == N ? i : tail_at;
+            }
+        }
+
+        if (tail_at != last_positional && tail_at != N)
+            return table_error::misplaced_tail;
+
+        /* repeated keys hash alike, which leaves a perfect hash imperfect: only
+         * then are they sorted to be looked for. */
+        auto const distinct = [](size_t n, auto const &key) {
+            return detail::perfect_hash<N>(n, key).perfect || detail::all_distinct<N>(n, key);
+        };
+        if (!distinct(N, [&](size_t j) { return arguments[j].name; }))
+            return table_error::repeated_name;
+        if (!distinct(n_env_names, [&](size_t j) { return env_names[j]; }))
+            return table_error::repeated_env;
+        return table_error::none;
+    }
+
+    /* a resolved argument name. See parser::id. */
+    struct arg_id {
+        size_t index = N;
+    };
+
+    /* a set of arguments as bits indexed like ids, to test many at once. */
+    struct arg_mask {
+        static constexpr size_t words = (N + 63) / 64;
+
+        std::array<uint64_t, words> bits{};
+
+        constexpr void set(arg_id id) noexcept {
+            if (id.index < N)
+                bits[id.index / 64] |= uint64_t(1) << (id.index % 64);
+        }
+
+        constexpr bool has(arg_id id) const noexcept {
+            return id.index < N && bits[id.index / 64] >> (id.index % 64) & 1;
+        }
+
+        /* whether every argument of m is in the set, or any is. */
+        constexpr bool all(arg_mask const &m) const noexcept {
+            uint64_t missing = 0;
+            for (size_t w = 0; w < words; ++w)
+                missing |= m.bits[w] & ~bits[w];
+            return !missing;
+        }
+
+        constexpr bool any(arg_mask const &m) const noexcept {
+            uint64_t common = 0;
+            for (size_t w = 0; w < words; ++w)
+                common |= m.bits[w] & bits[w];
+            return common;
+        }
+    };
+
+    /* the set of the named arguments. As with id, unknown names fail to compile
+     * in a constant expression. */
+    constexpr arg_mask mask(std::initializer_list<std::string_view> arg_names) const
+        noexcept {
+        arg_mask res;
+        for (auto name : arg_names)
+            res.set(id(name));
+        return res;
+    }
+
+    /* Resolves an argument name to a handle that indexes parsed_args directly,
+     * with no name search. Evaluated in a constant expression (e.g. to initialize
+     * a constexpr variable), an unknown name fails to compile; at runtime it
+     * yields a handle that is never set. */
+    constexpr arg_id id(std::string_view name) const noexcept {
+        auto const i = find_name(name);
+        if (i == N)
+            detail::unknown_argument_name();
+        return {i};
+    }
+
+    /* Where the values of each argument are, as offsets into the parsed words or
+     * the environment, which must outlive it. Names (in operator[], count and
+     * each) are resolved by the parser, which must outlive it too: a function
+     * cannot return what its own local parser parsed, unless that parser is
+     * static constexpr. Ids (see id) and rest() need no parser. Parsing with a
+     * temporary parser does not compile. */
+    struct parsed_args {
+        bool ok = true;
+
+    private:
+        /* the tail positional (see rest), as the parser has it. Next to ok, it
+         * takes no room of its own. */
+        uint32_t tail = static_cast<uint32_t>(N);
+
+    public:
+
+        struct arg_proxy {
+            labeled_arg arg;
+            bool &ok;
+
+            template <typename T>
+            constexpr auto operator|(T default_value) const noexcept {
+                if (!arg.present())
+                    return std::optional<T>{std::move(default_value)};
+                return unwrap<T>();
+            }
+
+            template <typename T>
+            constexpr std::optional<T> operator|(std::optional<T> const &) const noexcept {
+                if (!arg.present()) {
+                    ok = false;
+                    return std::nullopt;
+                }
+                return unwrap<T>();
+            }
+
+            constexpr operator bool() const noexcept { return arg.present(); }
+
+            /* Splits the value on delim into out[0, capacity), each element as a T
+             * (see list). How many there are: none if the argument is not given,
+             * nullopt if one fails to convert or they do not fit. */
+            template <typename T>
+            constexpr std::optional<size_t> split(T *out, size_t capacity,
+                                                  char delim = ',') const noexcept {
+                size_t n = 0;
+                if (!arg.present())
+                    return n;
+
+                auto const into = [&](T const &value) {
+                    if (n == capacity)
+                        return false;
+                    out[n++] = value;
+                    return true;
+                };
+                if (arg.argc == 1 && arg.visit([&](int, auto words) {
+                        return detail::split_list<T>(std::string_view(words[0]), delim,
+                                                     into);
+                    }))
+                    return n;
+                ok = false;
+                return std::nullopt;
+            }
+
+            arg_proxy &operator=(arg_proxy &&) = delete;
+
+        private:
+            template <typename T>
+            constexpr std::optional<T> unwrap() const noexcept {
+                /* before C++20, std::optional<T> can only be moved in a constant
+                 * expression if T is trivially copyable. For other types, keep the
+                 * result a prvalue and check it with a second conversion. */
+                auto const get = [](int argc, auto words) {
+                    return unwrapper<T>::get(argc, words);
+                };
+                if (detail::is_constant_evaluated() && !std::is_trivially_copyable_v<T>) {
+                    if (!arg.visit(get))
+                        ok = false;
+                    return arg.visit(get);
+                }
 
-/* Trick to parse numeric types using from_chars when available.
- * Important: the fallback versions assume a null terminator, so
- * this can be dangerous in other contexts. */
-template <typename T, typename = void>
-struct str_to_num {
-    static std::optional<T> get(char const *str, char const *str_end) noexcept {
+                auto result = arg.visit(get);
+                if (!result)
+                    ok = false;
+                return result;
+            }
+        };
 
-        if ((str_end - str) > 2 && std::tolower(str[1]) == 'x')
-            return std::nullopt;
+        constexpr arg_proxy operator[](std::string_view name) noexcept {
+            return (*this)[arg_id{p ? p->find_name(name) : N}];
+        }
 
-        char *p = nullptr;
-        errno = 0;
+        constexpr arg_proxy operator[](arg_id id) noexcept {
+            return {id.index < N ? resolve(id.index) : labeled_arg{}, ok};
+        }
 
-        T result = [&]() {
-            if constexpr (std::is_same_v<T, float>)
-                return std::strtof(str, &p);
-            if constexpr (std::is_same_v<T, double>)
-                return std::strtod(str, &p);
-            if constexpr (std::is_same_v<T, long double>)
-                return std::strtold(str, &p);
+        /* the arguments given, e.g. args.present().any(parser.mask({"-v", "-q"})). */
+        constexpr arg_mask const &present() const noexcept { return given; }
 
-            if constexpr (std::is_integral_v<T>) {
-                auto n = [&]() {
-                    if constexpr (std::is_signed_v<T>)
-                        return std::strtoll(str, &p, 10);
-                    else
-                        return std::strtoull(str, &p, 10);
-                }();
+        /* how many times an argument was given, as in -v -v -v. */
+        constexpr size_t count(arg_id id) const noexcept {
+            return id.index < N ? slots[id.index].times : 0;
+        }
 
-                if (n < std::numeric_limits<T>::min() || n > std::numeric_limits<T>::max())
-                    errno = ERANGE;
+        constexpr size_t count(std::string_view name) const noexcept {
+            return count(arg_id{p ? p->find_name(name) : N});
+        }
 
-                return static_cast<T>(n);
-            }
-        }();
+        /* The values of each occurrence of a repeatable argument, in order, as
+         * std::optional<T>s that are empty where they do not convert. Empty
+         * unless parsed with an occurrences storage. */
+        template <typename T>
+        struct occurrence_range {
+            struct iterator {
+                using iterator_category = std::input_iterator_tag;
+                using value_type = std::optional<T>;
+                using difference_type = ptrdiff_t;
+                using pointer = void;
+                using reference = std::optional<T>;
 
-        return (!errno && p == str_end) ? std::optional<T>{result} : std::nullopt;
-    }
-};
+                parsed_args const *args;
+                size_t ai, i;
 
-/* specialization available if the corresponding from_chars overload is present. */
-template <typename T>
-struct str_to_num<T, std::void_t<decltype(std::from_chars(nullptr, nullptr, std::declval<T &>()))>> {
-    static std::optional<T> get(char const *str, char const *str_end) noexcept {
-        T result;
-        auto [p, ec] = std::from_chars(str, str_end, result);
-        return (ec == std::errc() && p == str_end) ? std::optional<T>{result} : std::nullopt;
-    }
-};
+                constexpr std::optional<T> operator*() const noexcept {
+                    auto const arg = args->resolve(args->seen[i]);
+                    return arg.visit([](int argc, auto words) {
+                        return unwrapper<T>::get(argc, words);
+                    });
+                }
 
-template <typename T>
-constexpr bool is_tuple = false;
+                constexpr iterator &operator++() noexcept {
+                    i = args->next(ai, i + 1);
+                    return *this;
+                }
 
-template <typename... Ts>
-constexpr bool is_tuple<std::tuple<Ts...>> = true;
+                constexpr iterator operator++(int) noexcept {
+                    auto res = *this;
+                    ++*this;
+                    return res;
+                }
 
-template <typename T, size_t N>
-constexpr bool is_tuple<std::array<T, N>> = true;
-} // namespace detail
+                constexpr bool operator==(iterator const &o) const noexcept {
+                    return i == o.i;
+                }
 
-template <typename T, typename = void>
-struct unwrapper {
-    static std::optional<T> get(int argc, char const *const *argv) noexcept {
-        return (argc == 1) ? std::optional<T>{argv[0]} : std::nullopt;
-    }
-};
+                constexpr bool operator!=(iterator const &o) const noexcept {
+                    return i != o.i;
+                }
+            };
 
-template <typename T>
-struct unwrapper<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
-    static std::optional<T> get(int argc, char const *const *argv) noexcept {
-        if (argc != 1)
-            return std::nullopt;
-        auto val = std::string_view(argv[0]);
-        return detail::str_to_num<T>::get(val.data(), val.data() + val.size());
-    }
-};
+            parsed_args const *args;
+            size_t ai;
 
-template <typename T>
-struct unwrapper<T, std::enable_if_t<detail::is_tuple<T>>> {
-    template <size_t... I>
-    static constexpr std::optional<T> get_tuple(char const *const *argv,
-                                                std::index_sequence<I...>) noexcept {
-        auto opts =
-            std::make_tuple(unwrapper<std::tuple_element_t<I, T>>::get(1, argv + I)...);
-        bool ok = (!!std::get<I>(opts) && ...);
+            constexpr iterator begin() const noexcept {
+                return {args, ai, args->next(ai, 0)};
+            }
+            constexpr iterator end() const noexcept { return {args, ai, args->n_seen}; }
+        };
 
-        return ok ? std::optional<T>{{*std::get<I>(opts)...}} : std::nullopt;
-    }
+        /* the words of the tail (see arg): the end of the parsed words, and so of
+         * argv, which stays null-terminated as execv needs. */
+        struct tail_words {
+            int argc = 0;
+            /* in one of these, as parsed */
+            char const *const *argv = nullptr;
+            std::string_view const *views = nullptr;
+        };
 
-    static std::optional<T> get(int argc, char const *const *argv) noexcept {
-        return (static_cast<size_t>(argc) == std::tuple_size_v<T>)
-                   ? get_tuple(argv, std::make_index_sequence<std::tuple_size_v<T>>{})
-                   : std::nullopt;
-    }
-};
+        constexpr tail_words rest() const noexcept {
+            tail_words res;
+            if (tail == N || slots[tail].source != from_words)
+                return res;
+            auto const offset = slots[tail].offset;
+            res.argc = static_cast<int>(n_words - offset);
+            if (views)
+                res.views = views + offset;
+            else
+                res.argv = argv + offset;
+            return res;
+        }
 
-template <size_t N>
-class parser {
-private:
-    struct labeled_arg {
-        std::string_view name;
-        int argc = 0;
-        char const *const *argv = nullptr;
-    };
+        template <typename T>
+        constexpr occurrence_range<T> each(arg_id id) const noexcept {
+            return {this, id.index};
+        }
 
-public:
-    struct arg {
-        std::string_view name;
-        std::string_view desc;
+        template <typename T>
+        constexpr occurrence_range<T> each(std::string_view name) const noexcept {
+            return {this, p ? p->find_name(name) : N};
+        }
 
-        ptrdiff_t nargs = 1;
+    private:
+        friend class parser;
 
-        constexpr labeled_arg parse(ptrdiff_t argc, char const *const *&argv) const noexcept {
+        enum : uint8_t { absent, from_words, from_env, from_config };
 
-            argc = std::min(argc, nargs);
-            auto cur_argv = argv;
-            argv += nargs - 1;
+        struct slot {
+            uint32_t offset = 0;
+            uint16_t count = 0;
+            uint8_t source = absent;
+            uint16_t skip = 0; /* see labeled_arg::skip */
+            uint16_t times = 0;
+        };
 
-            if (nargs > 1 && is_switch(name)) {
-                argc -= 1;
-                cur_argv += 1;
-            }
+        constexpr void set(size_t ai, slot s) noexcept {
+            s.times = slots[ai].times + (slots[ai].times < 0xffff);
+            slots[ai] = s;
+            given.set({ai});
+        }
 
-            return labeled_arg{name, static_cast<int>(argc), cur_argv};
+        /* the first occurrence of argument ai from i on, or n_seen. */
+        constexpr size_t next(size_t ai, size_t i) const noexcept {
+            while (i < n_seen && seen[i].arg != ai)
+                ++i;
+            return i;
         }
 
-        constexpr arg() noexcept = default;
-        constexpr arg(std::string_view name, std::string_view desc, size_t nargs = 0) noexcept
-          : name(name), desc(desc), nargs(1 + nargs) {}
-    };
+        constexpr labeled_arg resolve(detail::occurrence const &o) const noexcept {
+            auto res = views ? labeled_arg::make(o.count, views + o.offset)
+                             : labeled_arg::make(o.count, argv + o.offset);
+            res.skip = o.skip;
+            return res;
+        }
 
-    constexpr parser(arg const (&arguments)[N]) noexcept {
-        for (auto i = std::begin(arguments), e = std::end(arguments); i != e; ++i) {
-            assert(is_valid(i->name));
-            if (!is_switch(i->name))
-                args[n_positionals++] = *i;
+        template <typename Words>
+        constexpr void set_words(Words words) noexcept {
+            if constexpr (std::is_convertible_v<Words, std::string_view const *>)
+                views = words;
+            else
+                argv = words;
         }
-        for (auto i = std::begin(arguments), e = std::end(arguments); i != e; ++i) {
-            if (is_switch(i->name))
-                args[n_positionals + n_switches++] = *i;
+
+        constexpr labeled_arg resolve(size_t ai) const noexcept {
+            auto const &s = slots[ai];
+            labeled_arg res;
+            if (s.source == from_env) {
+                res = labeled_arg::make(1, envp + s.offset);
+                res.skip = s.skip;
+            } else if (s.source == from_words) {
+                res = views ? labeled_arg::make(s.count, views + s.offset)
+                            : labeled_arg::make(s.count, argv + s.offset);
+                res.skip = s.skip;
+            } else if (s.source == from_config) {
+                res = labeled_arg::make(s.count, config + s.offset);
+            }
+            return res;
         }
 
-        size_t i = 0;
-        for ([[maybe_unused]] auto &a : args) {
-            for (size_t j = ++i; j < N; ++j)
-                assert(a.name != args[j].name && "no repeated names.");
+        parser const *p = nullptr;
+        char const *const *argv = nullptr;
+        std::string_view const *views = nullptr;
+        char const *const *envp = nullptr;
+        std::string_view const *config = nullptr;
+        std::array<slot, N> slots{};
+        arg_mask given;
+        detail::occurrence const *seen = nullptr;
+        uint32_t n_seen = 0; /* at most argc */
+        uint32_t n_words = 0;
+    };
+
+    /* a parsed_args refers to its parser, so parsing with a temporary one (as in
+     * carp::parser({...}).parse(argc, argv)) does not compile. */
+    template <typename... Args>
+    void parse(Args &&...) const && = delete;
+    template <typename... Args>
+    void parse_env(Args &&...) const && = delete;
+    template <typename... Args>
+    void parse_config(Args &&...) const && = delete;
+    template <typename... Args>
+    void unpack(Args &&...) const && = delete;
+
+    [[nodiscard]] constexpr parsed_args parse(int argc,
+                                              char const *const *argv) const & noexcept {
+        return parse_words(argc, argv);
+    }
+
+    /* the same, for words that are not null-terminated. */
+    [[nodiscard]] constexpr parsed_args
+    parse(int argc, std::string_view const *argv) const & noexcept {
+        return parse_words(argc, argv);
+    }
+
+    /* the same, with every occurrence of the repeatable arguments kept in list
+     * (see parsed_args::each), which the result refers to. Not ok if they do not
+     * fit. */
+    template <size_t capacity>
+    [[nodiscard]] constexpr parsed_args
+    parse(int argc, char const *const *argv,
+          occurrences<capacity> &list) const & noexcept {
+        auto res = parse_words(argc, argv, list.list, capacity);
+        list.n = res.n_seen;
+        return res;
+    }
+
+    template <size_t capacity>
+    [[nodiscard]] constexpr parsed_args
+    parse(int argc, std::string_view const *argv,
+          occurrences<capacity> &list) const & noexcept {
+        auto res = parse_words(argc, argv, list.list, capacity);
+        list.n = res.n_seen;
+        return res;
+    }
+
+    /* the same, with the arguments missing from argv taken from the environment
+     * entries of envp (see parse_env). */
+    [[nodiscard]] constexpr parsed_args parse(int argc, char const *const *argv,
+                                              char const *const *envp) const & noexcept {
+        auto res = parse(argc, argv);
+        parse_env(res, envp);
+        return res;
+    }
+
+    /* Sets the arguments of res that are still missing from the variables bound
+     * to them (see arg::env), in a single pass over envp: a null-terminated array
+     * of NAME=value entries, like environ or main's third parameter. The command
+     * line takes priority, then the first entry for a variable. A switch without a
+     * value is set by an empty variable or true, and not by false, as in a
+     * config_file; any other value is not ok. res then refers to envp. */
+    constexpr void parse_env(parsed_args &res, char const *const *envp) const & noexcept {
+        if (!n_env || !envp)
+            return;
+        res.p = this;
+        res.envp = envp;
+        for (auto const first = envp; *envp; ++envp) {
+            auto const entry = *envp;
+            size_t eq = 0;
+            while (entry[eq] && entry[eq] != '=')
+                ++eq;
+            if (!entry[eq] || eq >= 0xffff)
+                continue;
+
+            auto const j = env_lookup.find(std::string_view(entry, eq),
+                                           [this](size_t k) { return env_name(k); });
+            if (j == N || res.slots[env_args[j]].source != parsed_args::absent)
+                continue;
+            if (nargs[env_args[j]] == 1 && env_args[j] >= n_positionals) {
+                auto const value = std::string_view(entry + eq + 1);
+                if (value == "false")
+                    continue;
+                if (!value.empty() && value != "true") {
+                    res.ok = false;
+                    continue;
+                }
+            }
+            /* the value follows NAME= */
+            res.set(env_args[j], {static_cast<uint32_t>(envp - first), 1,
+                                  parsed_args::from_env, static_cast<uint16_t>(eq + 1)});
         }
     }
 
-    struct parsed_args {
-        bool ok = true;
-        std::array<labeled_arg, N> args;
+    /* the same, with the switches missing from argv taken from config (see
+     * parse_config). */
+    template <size_t max_values, size_t max_chars>
+    [[nodiscard]] parsed_args
+    parse(int argc, char const *const *argv,
+          config_file<max_values, max_chars> const &config) const & noexcept {
+        auto res = parse(argc, argv);
+        parse_config(res, config);
+        return res;
+    }
 
-        struct arg_proxy {
-            labeled_arg const *arg;
-            bool &ok;
+    /* Sets the switches of res that are still missing from the lines of config
+     * (see config_file), in a single pass over them. Keys are found like the
+     * switches of the command line, which takes priority, and for a key given
+     * more than once, its first line. Calling parse_env first gives the
+     * environment priority over the file. Not ok if a key names no switch, or
+     * its values are not as many as the switch takes or did not fit config. res
+     * then refers to config's values, which are views of its text; config is
+     * left as it is, so it can serve any number of parses. */
+    template <size_t max_values, size_t max_chars>
+    void parse_config(parsed_args &res,
+                      config_file<max_values, max_chars> const &config) const & noexcept {
+        res.p = this;
+        res.config = config.words.data();
+        if (!config.complete)
+            res.ok = false;
 
-            template <typename T>
-            constexpr auto operator|(T default_value) const noexcept {
-                auto result = arg ? unwrapper<T>::get(arg->argc, arg->argv)
-                                  : std::move(default_value);
-                if (!result)
-                    ok = false;
-                return result;
+        for (size_t i = 0; i < config.n_lines; ++i) {
+            auto const &line = config.lines[i];
+            auto const ai = config_switch(line.key);
+            if (ai == N) {
+                res.ok = false;
+                continue;
             }
+            if (res.slots[ai].source != parsed_args::absent)
+                continue;
 
-            template <typename T>
-            constexpr std::optional<T> operator|(std::optional<T> const &) const noexcept {
-                auto result = arg ? unwrapper<T>::get(arg->argc, arg->argv) : std::nullopt;
-                if (!result)
-                    ok = false;
-                return result;
+            if (!line.fits) {
+                res.ok = false;
+            } else if (nargs[ai] == 1) {
+                auto const value =
+                    line.count ? config.words[line.first] : std::string_view("true");
+                if (line.count > 1 || (value != "true" && value != "false"))
+                    res.ok = false;
+                else if (value == "true")
+                    res.set(ai, {0, 0, parsed_args::from_config});
+            } else if (nargs[ai] == 2 && line.count > 1) {
+                /* a switch taking one value takes the rest of the line */
+                res.set(ai, {line.first - 1, 1, parsed_args::from_config});
+            } else if (line.count + 1 == nargs[ai]) {
+                res.set(ai, {line.first, line.count, parsed_args::from_config});
+            } else {
+                res.ok = false;
             }
+        }
+    }
 
-            operator bool() const { return !!arg; }
+    /* the same, with @path words expanded to the words of response files (see
+     * response_arena). The result refers to arena. */
+    template <size_t max_words, size_t max_chars, size_t max_files>
+    [[nodiscard]] parsed_args
+    parse(int argc, char const *const *argv,
+          response_arena<max_words, max_chars, max_files> &arena) const & noexcept {
+        if (!arena.expand(argc, argv)) {
+            parsed_args res;
+            res.ok = false;
+            return res;
+        }
+        return parse(static_cast<int>(arena.size()), arena.data());
+    }
 
-            arg_proxy &operator=(arg_proxy &&) = delete;
-        };
+    /* Splits cmdline into tokens (see token_buffer) and parses its words, the
+     * first being the program name. The result refers to tokens and cmdline. */
+    template <size_t max_words, size_t max_chars>
+    [[nodiscard]] constexpr parsed_args
+    parse(std::string_view cmdline,
+          token_buffer<max_words, max_chars> &tokens) const & noexcept {
+        if (!tokens.split(cmdline)) {
+            parsed_args res;
+            res.ok = false;
+            return res;
+        }
+        return parse(static_cast<int>(tokens.size()), tokens.data());
+    }
 
-        constexpr arg_proxy operator[](std::string_view name) noexcept {
-            auto it = std::find_if(args.begin(), args.end(),
-                                   [&](auto &r) { return r.name == name; });
+    /* the same, for words each ending with a '\0', as in /proc/<pid>/cmdline. */
+    template <size_t max_words, size_t max_chars>
+    [[nodiscard]] constexpr parsed_args
+    parse(std::string_view cmdline, token_buffer<max_words, max_chars> &tokens,
+          nul_delimited_t) const & noexcept {
+        if (!tokens.split(cmdline, nul_delimited)) {
+            parsed_args res;
+            res.ok = false;
+            return res;
+        }
+        return parse(static_cast<int>(tokens.size()), tokens.data());
+    }
+
+    /* Caller-owned results of parse_batch, one row per command line, as columns
+     * indexed by row * N + argument index (see parser::id). offsets and counts
+     * locate an argument's values in its row's argv, and are only set where the
+     * argument is present. The high 16 bits of a count are the characters before
+     * a value attached to its switch, as in -j8. */
+    struct parsed_batch {
+        static constexpr size_t words = (N + 63) / 64;
 
-            return {it != args.end() ? &(*it) : nullptr, ok};
+        uint64_t *present = nullptr; /* rows * words, bit i of a row for argument i */
+        uint32_t *offsets = nullptr; /* rows * N */
+        uint32_t *counts = nullptr;  /* rows * N */
+        bool *ok = nullptr;          /* rows */
+        size_t rows = 0;
+
+        constexpr bool has(size_t row, arg_id id) const noexcept {
+            return id.index < N && present[row * words + id.index / 64] >> (id.index % 64) & 1;
         }
     };
 
-    [[nodiscard]] parsed_args parse(int argc, char const *const *argv) const noexcept {
+    /* Parses each (argc, argv) pair of lines into a row of out, without building
+     * a parsed_args per line. Returns the number of rows written, at most out.rows. */
+    template <typename Lines>
+    constexpr size_t parse_batch(Lines const &lines, parsed_batch const &out) const noexcept {
+        size_t row = 0;
+        for (auto const &line : lines) {
+            if (row == out.rows)
+                break;
+            auto const &[argc, argv] = line;
+            auto const present = out.present + row * parsed_batch::words;
+            auto const offsets = out.offsets + row * N, counts = out.counts + row * N;
 
-        parsed_args res;
+            for (size_t w = 0; w < parsed_batch::words; ++w)
+                present[w] = 0;
+            out.ok[row++] = classify(argc, argv, [&](size_t ai, labeled_arg const &arg) {
+                present[ai / 64] |= uint64_t(1) << (ai % 64);
+                offsets[ai] = static_cast<uint32_t>(arg.offset(argv));
+                counts[ai] =
+                    static_cast<uint32_t>(std::min(arg.argc, 0xffff)) | arg.skip << 16;
+            });
+        }
+        return row;
+    }
 
-        size_t pos_i = 0;
-        for (auto it = argv + 1, end = argv + argc; it < end; ++it) {
-            auto const word = std::string_view(*it);
+    /* a row of a batch as the parsed_args of its argv. */
+    template <typename Words>
+    constexpr parsed_args unpack(parsed_batch const &batch, size_t row,
+                                 Words argv) const & noexcept {
+        parsed_args res;
+        res.ok = batch.ok[row];
+        res.p = this;
+        res.tail = static_cast<uint32_t>(tail);
+        res.set_words(argv);
+        for (size_t ai = 0; ai < N; ++ai) {
+            if (!batch.has(row, {ai}))
+                continue;
+            auto const count = batch.counts[row * N + ai];
+            res.set(ai, {batch.offsets[row * N + ai], static_cast<uint16_t>(count),
+                         parsed_args::from_words, static_cast<uint8_t>(count >> 16)});
+            res.n_words =
+                std::max(res.n_words, batch.offsets[row * N + ai] + (count & 0xffff));
+        }
+        return res;
+    }
 
-            size_t const ai =
-                is_switch(word) ? find_switch(word) : pos_i < n_positionals ? pos_i++ : N;
+    /* Arguments bound to the members of a Struct, converted straight into them by
+     * parse_into as argv is scanned. Made by parser::bind. */
+    template <typename Struct>
+    class binder {
+    public:
+        /* bit i of failed is set when argument i (see parser::id) did not convert,
+         * and ok is as in parsed_args. */
+        struct result {
+            bool ok = true;
+            std::array<uint64_t, (N + 63) / 64> failed{};
 
-            if (ai < N) {
-                res.args[ai] = args[ai].parse(end - it, it);
-            } else { /* unrecognized switch or too many positionals */
-                res.ok = false;
+            constexpr bool has(arg_id id) const noexcept {
+                return id.index < N && failed[id.index / 64] >> (id.index % 64) & 1;
             }
+        };
+
+        /* members of absent arguments are left as they are. */
+        template <typename Words>
+        constexpr result parse_into(int argc, Words argv, Struct &out) const noexcept {
+            result res;
+            bool const words_ok =
+                p.classify(argc, argv, [&](size_t ai, labeled_arg const &arg) {
+                    if (setters[ai] && !setters[ai](out, arg)) {
+                        res.failed[ai / 64] |= uint64_t(1) << (ai % 64);
+                        res.ok = false;
+                    }
+                });
+            res.ok = res.ok && words_ok;
+            return res;
         }
 
+        constexpr parser const &get_parser() const noexcept { return p; }
+
+    private:
+        friend class parser;
+        using setter = bool (*)(Struct &, labeled_arg const &) noexcept;
+
+        constexpr explicit binder(parser const &p) noexcept : p(p) {}
+
+        parser p;
+        std::array<setter, N> setters{};
+    };
+
+    /* Binds arguments to members of a struct, for parse_into:
+     *
+     *     constexpr auto cli = parser.bind(carp::field<&config::jobs>("-j"), ...);
+     *     auto res = cli.parse_into(argc, argv, cfg);
+     *
+     * A boolean switch sets a bool member to true; other values are converted by
+     * the unwrapper of the member's type. */
+    template <auto... Members>
+    constexpr auto bind(field<Members> const &...fields) const noexcept {
+        static_assert(sizeof...(Members) > 0, "bind at least one member.");
+        using Struct =
+            std::tuple_element_t<0, std::tuple<typename field<Members>::object_type...>>;
+        static_assert(
+            (std::is_same_v<Struct, typename field<Members>::object_type> && ...),
+            "members of a single struct.");
+
+        binder<Struct> res(*this);
+        auto const add = [&](auto member, std::string_view name) {
+            constexpr auto Member = decltype(member)::value;
+            auto const ai = find_name(name);
+            if (ai == N) {
+                detail::unknown_argument_name();
+                return;
+            }
+            assert(!res.setters[ai] && "no argument bound twice.");
+            res.setters[ai] = &assign<Member>;
+            if constexpr (std::is_same_v<typename field<Member>::value_type, bool>) {
+                if (nargs[ai] == 1 && ai >= n_positionals)
+                    res.setters[ai] = &flag<Member>;
+            }
+        };
+        (add(std::integral_constant<decltype(Members), Members>{}, fields.name), ...);
         return res;
     }
 
@@ -261,6 +3071,51 @@ public:
         return usage_holder{program_name, this, max_cols};
     }
 
+    /* The same usage text, written to buf, of which capacity characters. Returns
+     * its length, which is more than capacity if it was cut short. */
+    constexpr size_t usage_to(char *buf, size_t capacity, std::string_view program_name,
+                              unsigned max_cols = 80) const noexcept {
+        size_t n = 0;
+        render_usage(program_name, max_cols, [&](std::string_view piece) {
+            auto const m = n < capacity ? std::min(piece.size(), capacity - n) : 0;
+            if (m && !detail::is_constant_evaluated())
+                std::memcpy(buf + n, piece.data(), m);
+            else
+                for (size_t i = 0; i < m; ++i)
+                    buf[n + i] = piece[i];
+            n += piece.size();
+        });
+        return n;
+    }
+
+    constexpr size_t usage_size(std::string_view program_name,
+                                unsigned max_cols = 80) const noexcept {
+        return usage_to(nullptr, 0, program_name, max_cols);
+    }
+
+    /* The usage text rendered at compile time, for a parser and a program name
+     * known then:
+     *
+     *     static constexpr auto help =
+     *         parser.usage_text<parser.usage_size("tool")>("tool");
+     */
+    template <size_t K>
+    constexpr std::array<char, K> usage_text(std::string_view program_name,
+                                             unsigned max_cols = 80) const noexcept {
+        std::array<char, K> res{};
+        usage_to(res.data(), K, program_name, max_cols);
+        return res;
+    }
+
+#if CARP_HAS_UNISTD
+    /* Renders the usage text into buf and writes it to fd in a single write(). */
+    bool write_usage(int fd, char *buf, size_t capacity, std::string_view program_name,
+                     unsigned max_cols = 80) const noexcept {
+        auto const n = usage_to(buf, capacity, program_name, max_cols);
+        return n <= capacity && ::write(fd, buf, n) == static_cast<ssize_t>(n);
+    }
+#endif
+
 private:
     struct usage_holder {
         std::string_view program_name;
@@ -272,40 +3127,62 @@ private:
 
     template <typename stream>
     friend stream &operator<<(stream &os, const usage_holder &uh) noexcept {
-        using std::size;
-        auto &p = *uh.p;
+        uh.p->render_usage(uh.program_name, uh.max_cols,
+                           [&](std::string_view piece) { os << piece; });
+        return os;
+    }
+
+    /* passes the usage text to emit, in pieces. */
+    template <typename Emit>
+    constexpr void render_usage(std::string_view program_name, unsigned max_cols,
+                                Emit &&emit) const noexcept {
         constexpr auto indent = std::string_view{"        "};
+        constexpr auto spaces = std::string_view{"                                "};
+        auto const pad = [&](size_t n) {
+            while (n > spaces.size()) {
+                emit(spaces);
+                n -= spaces.size();
+            }
+            emit(spaces.substr(0, n));
+        };
+
+        emit("Usage: ");
+        auto const last_slash = program_name.find_last_of("/\\");
+        emit(program_name.substr(last_slash + 1, program_name.size() - last_slash));
 
-        os << "Usage: ";
-        auto const last_slash = uh.program_name.find_last_of("/\\");
-        os << uh.program_name.substr(last_slash + 1, uh.program_name.size() - last_slash);
+        if (n_switches > 0)
+            emit(" [options]");
 
-        if (p.n_switches > 0)
-            os << " [options]";
+        for (size_t ai = 0; ai < n_positionals; ++ai) {
+            emit(" ");
+            emit(names[ai]);
+        }
 
-        for (auto pi = p.args.begin(); pi != p.args.begin() + p.n_positionals; ++pi)
-            os << " " << pi->name;
+        size_t max_size = 0;
+        for (auto name : names)
+            max_size = std::max(max_size, name.size());
+        max_size += 3;
 
-        auto max_size =
-            3 + std::accumulate(p.args.begin(), p.args.end(), size_t{0},
-                                [](auto c, auto &a) { return std::max(c, size(a.name)); });
-        if (p.n_positionals)
-            os << "\n\nArguments:";
+        if (n_positionals)
+            emit("\n\nArguments:");
 
-        for (auto ai = p.args.begin(); ai != p.args.end(); ++ai) {
-            if (ai == p.args.begin() + p.n_positionals)
-                os << "\n\nOptions:";
+        for (size_t ai = 0; ai < N; ++ai) {
+            if (ai == n_positionals)
+                emit("\n\nOptions:");
 
-            os << "\n" << indent << ai->name;
-            std::fill_n(std::ostreambuf_iterator(os), max_size - size(ai->name), ' ');
+            auto const desc = descs[ai];
+            emit("\n");
+            emit(indent);
+            emit(names[ai]);
+            pad(max_size - names[ai].size());
 
-            size_t const max_per_line = uh.max_cols - max_size - size(indent) - 1;
-            for (size_t i = 0; i < size(ai->desc);) {
-                size_t eol = std::min(size(ai->desc) - i, max_per_line);
+            size_t const max_per_line = max_cols - max_size - indent.size() - 1;
+            for (size_t i = 0; i < desc.size();) {
+                size_t eol = std::min(desc.size() - i, max_per_line);
 
-                auto this_line = ai->desc.substr(i, eol);
+                auto this_line = desc.substr(i, eol);
 
-                size_t n;
+                size_t n = 0;
                 if ((n = this_line.find('\n')) != std::string_view::npos) {
                     this_line = this_line.substr(0, n);
                     eol = n + 1;
@@ -314,34 +3191,371 @@ private:
                     this_line = this_line.substr(0, eol = n + 1);
                 }
                 if (i) {
-                    os << "\n" << indent;
-                    std::fill_n(std::ostreambuf_iterator(os), max_size, ' ');
+                    emit("\n");
+                    emit(indent);
+                    pad(max_size);
                 }
-                os << this_line;
+                emit(this_line);
                 i += eol;
             }
         }
-        return os;
     }
 
     static constexpr bool is_switch(std::string_view word) noexcept {
-        return word.size() >= 2 && word[0] == '-' && !is_digit(word[1]);
+        return word.size() >= 2 && word[0] == '-' && !detail::is_digit(word[1]);
+    }
+
+    /* a positional named like "command..." takes every word from its own. */
+    static constexpr bool is_tail(std::string_view name) noexcept {
+        return name.size() >= 3 && name.substr(name.size() - 3) == "...";
     }
 
     static constexpr bool is_valid(std::string_view word) noexcept {
-        return !word.empty() && !is_digit(word[0]) && word.find(' ') == std::string_view::npos;
+        return !word.empty() && !detail::is_digit(word[0]) &&
+               word.find(' ') == std::string_view::npos;
+    }
+
+    /* matches each word of argv to an argument and passes their index and values
+     * to record. false if a word matches none. */
+    template <typename Words, typename Record>
+    constexpr bool classify(int argc, Words argv, Record &&record) const noexcept {
+        bool ok = true, options = true;
+        size_t pos_i = 0;
+        uint64_t dashes = 0;
+        auto block = argv + 1, block_end = block;
+        for (auto it = argv + 1, end = argv + argc; it < end; ++it) {
+            /* Only words starting with '-' need their length. For C strings,
+             * which those are is found for the next 64 words at once. */
+            bool dash = false;
+            if constexpr (std::is_convertible_v<Words, char const *const *>) {
+                if (it >= block_end) {
+                    block = it;
+                    auto const n = std::min<ptrdiff_t>(end - it, 64);
+                    block_end = it + n;
+                    dashes = detail::dash_mask(block, static_cast<size_t>(n));
+                }
+                dash = dashes >> (it - block) & 1;
+            } else {
+                auto const view = std::string_view(*it);
+                dash = !view.empty() && view[0] == '-';
+            }
+
+            std::string_view word;
+            bool option = false;
+            if (options && dash) {
+                word = std::string_view(*it);
+                if (word == "--") { /* only positionals from here on */
+                    options = false;
+                    continue;
+                }
+                option = is_switch(word);
+            }
+
+            size_t const ai =
+                option ? find_switch(word) : pos_i < n_positionals ? pos_i++ : N;
+
+            if (ai < N && ai == tail) {
+                record(ai, labeled_arg::make(static_cast<int>(end - it), it));
+                break;
+            } else if (ai < N) {
+                record(ai, take(ai, end - it, it));
+            } else if (!option || !(take_assigned(word, it, record) ||
+                                    take_cluster(word, end - it, it, record))) {
+                ok = false; /* unrecognized switch or too many positionals */
+            }
+        }
+        return ok;
+    }
+
+    template <auto Member>
+    static constexpr bool assign(typename field<Member>::object_type &out,
+                                 labeled_arg const &arg) noexcept {
+        using T = typename field<Member>::value_type;
+        auto value = arg.visit([](int argc, auto words) {
+            return unwrapper<T>::get(argc, words);
+        });
+        if (!value)
+            return false;
+        out.*Member = std::move(*value);
+        return true;
+    }
+
+    template <auto Member>
+    static constexpr bool flag(typename field<Member>::object_type &out,
+                               labeled_arg const &) noexcept {
+        out.*Member = true;
+        return true;
+    }
+
+    template <typename Words>
+    constexpr parsed_args parse_words(int argc, Words argv,
+                                      detail::occurrence *list = nullptr,
+                                      size_t capacity = 0) const noexcept {
+        parsed_args res;
+        res.p = this;
+        res.tail = static_cast<uint32_t>(tail);
+        res.set_words(argv);
+        res.seen = list;
+        bool fits = true;
+        res.n_words = static_cast<uint32_t>(argc);
+        auto const record = [&](size_t ai, labeled_arg const &arg) {
+            auto const offset = static_cast<uint32_t>(arg.offset(argv));
+            auto const count = static_cast<uint16_t>(std::min(arg.argc, 0xffff));
+            auto const skip = static_cast<uint8_t>(arg.skip);
+            res.set(ai, {offset, count, parsed_args::from_words, skip});
+            if (list && repeated.has({ai})) {
+                if (res.n_seen < capacity)
+                    list[res.n_seen++] = {offset, count, skip, static_cast<uint32_t>(ai)};
+                else
+                    fits = false;
+            }
+        };
+        bool const words_ok = classify(argc, argv, record);
+        res.ok = words_ok && fits;
+        return res;
+    }
+
+    /* the values of argument ai among the argc words at argv, which is left on
+     * the last word taken. */
+    template <typename Words>
+    constexpr labeled_arg take(size_t ai, ptrdiff_t argc, Words &argv) const noexcept {
+        ptrdiff_t const n = nargs[ai];
+        argc = std::min(argc, n);
+        auto values = argv;
+        argv += argc - 1;
+
+        if (n > 1 && ai >= n_positionals) {
+            argc -= 1;
+            values += 1;
+        }
+        return labeled_arg::make(static_cast<int>(argc), values);
+    }
+
+    /* a switch taking one value, given after '=' in the same word: --threads=8.
+     * The value is the rest of the word. */
+    template <typename Words, typename Record>
+    constexpr bool take_assigned(std::string_view word, Words argv,
+                                 Record &record) const noexcept {
+        auto const eq = word.find('=');
+        if (eq == std::string_view::npos || eq + 1 > 0xff)
+            return false;
+        size_t const ai = find_switch(word.substr(0, eq));
+        if (ai == N || nargs[ai] != 2)
+            return false;
+        auto value = labeled_arg::make(1, argv);
+        value.skip = static_cast<unsigned>(eq + 1);
+        record(ai, value);
+        return true;
+    }
+
+    /* The single-character switches clustered in word, as in -xvf, recorded as
+     * their own words. The last may take a value: the rest of the word, as in
+     * -xj8, or the words after it. A word that is not such a cluster records
+     * nothing. */
+    template <typename Words, typename Record>
+    constexpr bool take_cluster(std::string_view word, ptrdiff_t argc, Words &argv,
+                                Record &record) const noexcept {
+        if (word[1] == '-')
+            return false;
+        for (size_t k = 1; k < word.size(); ++k) {
+            size_t const ai = short_switches[static_cast<unsigned char>(word[k])];
+            if (ai == N)
+                return false;
+            if (nargs[ai] != 1) {
+                /* only a single value can be attached */
+                if (k + 1 < word.size() && (nargs[ai] > 2 || k + 1 > 0xff))
+                    return false;
+                break;
+            }
+        }
+
+        for (size_t k = 1; k < word.size(); ++k) {
+            size_t const ai = short_switches[static_cast<unsigned char>(word[k])];
+            if (nargs[ai] == 1) {
+                record(ai, labeled_arg::make(1, argv));
+            } else if (k + 1 == word.size()) {
+                record(ai, take(ai, argc, argv));
+            } else {
+                auto value = labeled_arg::make(1, argv);
+                value.skip = static_cast<unsigned>(k + 1);
+                record(ai, value);
+                return true;
+            }
+        }
+        return true;
+    }
+
+    constexpr std::string_view env_name(size_t j) const noexcept { return envs[env_args[j]]; }
+
+    constexpr size_t find_name(std::string_view name) const noexcept {
+        return lookup.find(name, [this](size_t j) { return names[j]; });
+    }
+
+    constexpr size_t find_switch(std::string_view word) const noexcept {
+        auto const i = find_name(word);
+        return i >= n_positionals ? i : N;
+    }
+
+    /* the switch named --key, or else -key (see config_file). */
+    size_t config_switch(std::string_view key) const noexcept {
+        char name[2 + 256] = {'-', '-'};
+        if (key.empty() || key[0] == '-' || key.size() > sizeof name - 2)
+            return N;
+        std::memcpy(name + 2, key.data(), key.size());
+        auto const i = find_switch({name, key.size() + 2});
+        return i != N ? i : find_switch({name + 1, key.size() + 1});
     }
 
-    static constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    size_t n_positionals = 0, n_switches = 0, tail = N;
 
-    size_t find_switch(std::string_view word) const noexcept {
-        return std::distance(begin(args),
-                             std::find_if(begin(args) + n_positionals, end(args),
-                                          [&](auto &s) { return s.name == word; }));
+    /* what parsing reads, positionals first: names, the number of words each
+     * argument takes (with the switch itself), and a hash of the names. */
+    std::array<std::string_view, N> names;
+    std::array<uint16_t, N> nargs{};
+    detail::perfect_hash<N> lookup;
+    /* the single-character switches by character, or N */
+    std::array<detail::index_t<N>, 256> short_switches{};
+    arg_mask repeated;
+
+    /* only read by usage() and parse_env: descriptions, environment variables,
+     * the arguments bound to them and a hash of their names. */
+    std::array<std::string_view, N> descs, envs;
+    size_t n_env = 0;
+    std::array<detail::index_t<N>, N> env_args{};
+    detail::perfect_hash<N> env_lookup;
+};
+
+/* A parser built at compile time from a table whose problems, NDEBUG or not,
+ * fail the build with a message each:
+ *
+ *     constexpr carp::arg table[] = {{"file", "the input"}, {"-v", "be verbose"}};
+ *     constexpr auto parser = carp::make_parser<table>();
+ */
+template <auto const &Arguments>
+constexpr auto make_parser() noexcept {
+    constexpr size_t N = std::extent_v<std::remove_reference_t<decltype(Arguments)>>;
+    constexpr auto error = parser<N>::validate(Arguments);
+    static_assert(error != table_error::invalid_name,
+                  "carp: a name is empty, starts with a digit or holds a space");
+    static_assert(error != table_error::ambiguous_name,
+                  "carp: a name is \"--\", a positional starting with '-' or a switch "
+                  "holding '='");
+    static_assert(error != table_error::repeated_name, "carp: a name is repeated");
+    static_assert(error != table_error::too_many_values,
+                  "carp: an argument takes more than 65534 values");
+    static_assert(error != table_error::repeated_positional,
+                  "carp: a positional is repeatable, as only switches can be");
+    static_assert(error != table_error::misplaced_tail,
+                  "carp: a positional named \"name...\" is not the last positional");
+    static_assert(error != table_error::bad_env,
+                  "carp: an environment name holds '=', or its argument takes "
+                  "several values");
+    static_assert(error != table_error::repeated_env,
+                  "carp: an environment name is repeated");
+
+    constexpr parser<N> res(Arguments);
+    return res;
+}
+
+/* a parser under the name of a subcommand, for commands. */
+template <typename Parser>
+struct command {
+    std::string_view name;
+    Parser parser;
+
+    constexpr command(std::string_view name, Parser const &parser) noexcept
+      : name(name), parser(parser) {}
+};
+
+/* Parsers selected by the subcommand named by argv[1], git-style:
+ *
+ *     constexpr auto tool = carp::commands(carp::command("run", carp::parser({...})),
+ *                                          carp::command("stat", carp::parser({...})));
+ *
+ * The name is found with a perfect hash, then only that command's parser runs. */
+template <typename... Parsers>
+class commands {
+public:
+    static constexpr size_t size = sizeof...(Parsers);
+
+    constexpr commands(command<Parsers> const &...cmds) noexcept
+      : names{cmds.name...}, parsers{cmds.parser...} {
+        for (size_t i = 0; i < size; ++i) {
+            assert(!names[i].empty() && names[i][0] != '-');
+            for (size_t j = i + 1; j < size; ++j)
+                assert(names[i] != names[j] && "no repeated names.");
+        }
+        lookup = detail::perfect_hash<size>(size, [this](size_t j) { return names[j]; });
+    }
+
+    /* the position of the command named name, or size if there is none. */
+    constexpr size_t find(std::string_view name) const noexcept {
+        return lookup.find(name, [this](size_t j) { return names[j]; });
+    }
+
+    /* the same, where an unknown name fails to compile in a constant expression. */
+    constexpr size_t index(std::string_view name) const noexcept {
+        auto const i = find(name);
+        if (i == size)
+            detail::unknown_command_name();
+        return i;
+    }
+
+    constexpr std::string_view name(size_t i) const noexcept { return names[i]; }
+
+    template <size_t I>
+    constexpr auto const &get() const noexcept {
+        return std::get<I>(parsers);
+    }
+
+    /* Parses the words after the command named by argv[1] with its parser, the
+     * command name standing in for the program name, and calls
+     *
+     *     f(std::integral_constant<size_t, I>{}, parsed_args &)
+     *
+     * for the command at I, which returns the same type for every command. The
+     * result is f's in an optional, or whether it was called if f returns void;
+     * it is not when argv[1] is missing or names no command. */
+    template <typename Words, typename F>
+    constexpr auto parse(int argc, Words argv, F &&f) const {
+        using fn = decltype(&call<0, Words, std::remove_reference_t<F>>);
+        using result = std::invoke_result_t<fn, commands const &, int, Words,
+                                            std::remove_reference_t<F> &>;
+
+        auto const i = argc < 2 ? size : find(std::string_view(argv[1]));
+        if constexpr (std::is_void_v<result>) {
+            if (i == size)
+                return false;
+            jump<Words, std::remove_reference_t<F>>[i](*this, argc - 1, argv + 1, f);
+            return true;
+        } else {
+            if (i == size)
+                return std::optional<result>();
+            return std::optional<result>(
+                jump<Words, std::remove_reference_t<F>>[i](*this, argc - 1, argv + 1, f));
+        }
+    }
+
+private:
+    template <size_t I, typename Words, typename F>
+    static constexpr decltype(auto) call(commands const &c, int argc, Words argv, F &f) {
+        auto args = std::get<I>(c.parsers).parse(argc, argv);
+        return f(std::integral_constant<size_t, I>{}, args);
+    }
+
+    template <typename Words, typename F, size_t... I>
+    static constexpr auto make_jump(std::index_sequence<I...>) noexcept {
+        return std::array{&call<I, Words, F>...};
     }
 
-    size_t n_positionals = 0, n_switches = 0;
-    std::array<arg, N> args;
+    /* a function per command, indexed by position. */
+    template <typename Words, typename F>
+    static constexpr auto jump =
+        make_jump<Words, F>(std::index_sequence_for<Parsers...>{});
+
+    std::array<std::string_view, size> names;
+    std::tuple<Parsers...> parsers;
+    detail::perfect_hash<size> lookup;
 };
 
 template <typename T>
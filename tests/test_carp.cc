@@ -1,5 +1,13 @@
 #include <carp.h>
 #include <catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 using namespace std::literals::string_view_literals;
 
@@ -708,7 +716,7 @@ TEST_CASE("Unwrapping numbers", "[unwrap_nums]") {
                          "as",
                          "100.",
                          ".1",
-                         "0xff1",
+                         "0xfg1",
                          "abc",
                          "u2",
                          "200000000000000000000000000000000000000000000",
@@ -742,7 +750,7 @@ TEST_CASE("Unwrapping numbers", "[unwrap_nums]") {
                          "as",
                          "100.",
                          ".1",
-                         "0xff1",
+                         "0xfg1",
                          "abc",
                          "u2",
                          "200000000000000000000000000000000000000000000",
@@ -907,26 +915,26 @@ TEST_CASE("Unwrapping arrays", "[unwrap_arrays]") {
                 using T = decltype(t);
 
                 check(std::array{T{}}, "1x");
-                check(std::array{T{}}, "0x1");
-                check(std::array{T{}, T{}}, "1", "0x2");
+                check(std::array{T{}}, "0x1z");
+                check(std::array{T{}, T{}}, "1", "0x2z");
                 check(std::array{T{}, T{}}, "1", "2x");
-                check(std::array{T{}, T{}}, "0x1", "2");
+                check(std::array{T{}, T{}}, "0x1z", "2");
                 check(std::array{T{}, T{}}, "1u", "2");
-                check(std::array{T{}, T{}, T{}}, "0x1", "2", "3");
-                check(std::array{T{}, T{}, T{}}, "1", "0x2", "3");
+                check(std::array{T{}, T{}, T{}}, "0x1z", "2", "3");
+                check(std::array{T{}, T{}, T{}}, "1", "0x2z", "3");
                 check(std::array{T{}, T{}, T{}}, "1", "2x", "3");
-                check(std::array{T{}, T{}, T{}}, "1", "2", "0x3");
+                check(std::array{T{}, T{}, T{}}, "1", "2", "0x3z");
                 check(std::array{T{}, T{}, T{}}, "1", "2", "3x");
                 check(std::array{T{}, T{}, T{}}, "1", "2",
                       "300000000000000000000000000000000000000000000000000");
                 check(std::array{T{}, T{}, T{}, T{}}, "1x", "2", "3", "4");
-                check(std::array{T{}, T{}, T{}, T{}}, "0x1", "2", "3", "4");
+                check(std::array{T{}, T{}, T{}, T{}}, "0x1z", "2", "3", "4");
                 check(std::array{T{}, T{}, T{}, T{}}, "1", "2x", "3", "4");
-                check(std::array{T{}, T{}, T{}, T{}}, "1", "0x2", "3", "4");
+                check(std::array{T{}, T{}, T{}, T{}}, "1", "0x2z", "3", "4");
                 check(std::array{T{}, T{}, T{}, T{}}, "1", "2", "3x", "4");
-                check(std::array{T{}, T{}, T{}, T{}}, "1", "2", "0x3", "4");
+                check(std::array{T{}, T{}, T{}, T{}}, "1", "2", "0x3z", "4");
                 check(std::array{T{}, T{}, T{}, T{}}, "1", "2", "3", "4x");
-                check(std::array{T{}, T{}, T{}, T{}}, "1", "2", "3", "0x4");
+                check(std::array{T{}, T{}, T{}, T{}}, "1", "2", "3", "0x4z");
             };
 
             SECTION("ints") { do_tests_for(int{}); }
@@ -1023,6 +1031,277 @@ TEST_CASE("Unwrapping tuples", "[unwrap_tuples]") {
     }
 }
 
+namespace {
+enum class level { trace, debug, info, notice, warning, error, critical, alert, emergency };
+enum unit : unsigned char { bytes = 1, kilo = 10, mega = 20, giga = 30 };
+} // namespace
+
+namespace carp {
+template <>
+struct enum_names<level> {
+    static constexpr std::pair<std::string_view, level> values[] = {
+        {"trace", level::trace},     {"debug", level::debug},
+        {"info", level::info},       {"notice", level::notice},
+        {"warning", level::warning}, {"warn", level::warning},
+        {"error", level::error},     {"critical", level::critical},
+        {"alert", level::alert},     {"emergency", level::emergency},
+    };
+};
+
+template <>
+struct enum_names<unit> {
+    static constexpr std::pair<std::string_view, unit> values[] = {
+        {"B", bytes}, {"K", kilo}, {"M", mega}, {"G", giga}};
+};
+} // namespace carp
+
+TEST_CASE("Unwrapping enums", "[unwrap_enums]") {
+    static constexpr auto parser = carp::parser({
+        {"--level", "how much to log", 1},
+        {"--units", "two units", 2},
+    });
+
+    SECTION("Every name resolves to its value") {
+        for (auto const &[name, value] : carp::enum_names<level>::values) {
+            std::string const word = std::string(name);
+            char const *const argv[] = {word.c_str()};
+            REQUIRE(carp::unwrapper<level>::get(1, argv) == value);
+        }
+        REQUIRE(carp::detail::enum_lookup<level>.perfect);
+    }
+
+    SECTION("Through operator|") {
+        char const *const argv[] = {"program", "--level=warn", "--units", "K", "G"};
+        auto args = parser.parse(5, argv);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--level"] | level::info) == level::warning);
+        REQUIRE(*(args["--units"] | carp::required<std::array<unit, 2>>) ==
+                std::array{kilo, giga});
+
+        char const *const none[] = {"program"};
+        auto defaults = parser.parse(1, none);
+        REQUIRE(*(defaults["--level"] | level::info) == level::info);
+        REQUIRE(!(defaults["--units"] | carp::required<std::tuple<unit, unit>>));
+        REQUIRE(!defaults.ok);
+    }
+
+    SECTION("Unknown names fail") {
+        for (char const *word : {"", "Info", "inf", "infos", "warning ", "0", "B"}) {
+            char const *const argv[] = {"program", "--level", word};
+            auto args = parser.parse(3, argv);
+            REQUIRE(args.ok);
+            REQUIRE(!(args["--level"] | level::info));
+            REQUIRE(!args.ok);
+        }
+    }
+
+    SECTION("Words split from a string") {
+        std::string_view const text = "errors";
+        std::string_view const words[] = {text.substr(0, 5), text};
+        REQUIRE(carp::unwrapper<level>::get(1, words) == level::error);
+        REQUIRE(!carp::unwrapper<level>::get(1, words + 1));
+
+        carp::token_buffer<4> tokens;
+        REQUIRE(tokens.split("program --level 'emergency'"));
+        auto args = parser.parse(static_cast<int>(tokens.size()), tokens.data());
+        REQUIRE(*(args["--level"] | level::info) == level::emergency);
+    }
+}
+
+TEST_CASE("Unwrapping sizes and durations", "[unwrap_units]") {
+    using namespace std::chrono;
+    using carp::byte_size;
+
+    auto size = [](char const *word) {
+        return carp::unwrapper<byte_size>::get(1, &word);
+    };
+    auto in = [](auto unit, char const *word) {
+        return carp::unwrapper<decltype(unit)>::get(1, &word);
+    };
+
+    SECTION("Byte sizes") {
+        REQUIRE(size("0") == byte_size{0});
+        REQUIRE(size("512B") == byte_size{512});
+        REQUIRE(size("4k") == byte_size{4000});
+        REQUIRE(size("4K") == byte_size{4000});
+        REQUIRE(size("4KB") == byte_size{4000});
+        REQUIRE(size("4KiB") == byte_size{4096});
+        REQUIRE(size("3M") == byte_size{3000000});
+        REQUIRE(size("3MiB") == byte_size{3 << 20});
+        REQUIRE(size("4GiB") == byte_size{4ull << 30});
+        REQUIRE(size("2TB") == byte_size{2000000000000});
+        REQUIRE(size("0007TiB") == byte_size{7ull << 40});
+        REQUIRE(size("18446744073709551615") == byte_size{18446744073709551615ull});
+        REQUIRE(size("18446744073709551K") == byte_size{18446744073709551000ull});
+
+        for (char const *word : {"", "K", "-1K", "+1K", " 1K", "1 K", "1Ki", "1kiB", "1m",
+                                 "1KiBs", "1.5G", "1e3", "0x10K", "18446744073709551616",
+                                 "18446744073709552K", "16777216TiB"}) {
+            INFO(word);
+            REQUIRE(!size(word));
+        }
+    }
+
+    SECTION("Durations") {
+        REQUIRE(in(nanoseconds{}, "17ns") == nanoseconds{17});
+        REQUIRE(in(nanoseconds{}, "17us") == microseconds{17});
+        REQUIRE(in(nanoseconds{}, "250ms") == milliseconds{250});
+        REQUIRE(in(milliseconds{}, "30s") == seconds{30});
+        REQUIRE(in(seconds{}, "5m") == minutes{5});
+        REQUIRE(in(seconds{}, "36h") == hours{36});
+        REQUIRE(in(hours{}, "7200s") == hours{2});
+        REQUIRE(in(duration<double>{}, "250ms") == duration<double>{0.25});
+        REQUIRE(in(duration<float, std::milli>{}, "3us")->count() == 0.003f);
+
+        /* only exact values, in range */
+        REQUIRE(!in(seconds{}, "1500ms"));
+        REQUIRE(!in(hours{}, "61m"));
+        REQUIRE(in(duration<int32_t>{}, "2147483647s"));
+        REQUIRE(!in(duration<int32_t>{}, "2147483648s"));
+        REQUIRE(!in(duration<int16_t, std::milli>{}, "33s"));
+        REQUIRE(!in(nanoseconds{}, "2562048h"));
+
+        for (char const *word :
+             {"", "ms", "10", "-5s", "10 s", "10S", "10sec", "1.5s", "10mss"}) {
+            INFO(word);
+            REQUIRE(!in(milliseconds{}, word));
+        }
+    }
+
+    SECTION("Through operator|, from argv and split strings") {
+        static constexpr auto parser = carp::parser({
+            {"--buffer", "buffer size", 1},
+            {"--timeout", "how long to wait", 1},
+        });
+
+        char const *const argv[] = {"program", "--buffer=64MiB", "--timeout", "1500ms"};
+        auto args = parser.parse(4, argv);
+        REQUIRE(*(args["--buffer"] | byte_size{4096}) == byte_size{64 << 20});
+        REQUIRE(*(args["--timeout"] | milliseconds{100}) == milliseconds{1500});
+        REQUIRE(!(args["--timeout"] | seconds{1}));
+        REQUIRE(!args.ok);
+
+        /* units are read up to the end of the view, not of the string */
+        std::string_view const text = "64KiBs 20ms";
+        std::string_view const words[] = {text.substr(0, 5), text.substr(7, 3)};
+        REQUIRE(carp::unwrapper<byte_size>::get(1, words) == byte_size{64 << 10});
+        REQUIRE(carp::unwrapper<microseconds>::get(1, words + 1) == minutes{20});
+    }
+}
+
+TEST_CASE("Delimited lists", "[lists]") {
+    static constexpr auto parser = carp::parser({
+        {"--cpus", "the CPUs to run on", 1},
+        {"--weights", "a weight per input", 1},
+        {"--names", "the shards", 1},
+        {"--sizes", "buffer sizes", 1},
+    });
+
+    SECTION("Into fixed arrays") {
+        char const *const argv[] = {"program", "--weights=0.5,0.25,0.25", "--names",
+                                    "east;west", "--sizes=4KiB,1M"};
+        auto args = parser.parse(5, argv);
+        REQUIRE(args.ok);
+
+        auto const weights = *(args["--weights"] | carp::required<carp::list<double, 4>>);
+        REQUIRE(weights.size == 3);
+        REQUIRE(std::vector<double>(weights.begin(), weights.end()) ==
+                std::vector<double>{0.5, 0.25, 0.25});
+
+        auto const names =
+            *(args["--names"] | carp::required<carp::list<std::string_view, 2, ';'>>);
+        REQUIRE(names.values == std::array{"east"sv, "west"sv});
+        REQUIRE(names[1].data() == argv[3] + 5);
+
+        auto const sizes = *(args["--sizes"] | carp::list<carp::byte_size, 2>{});
+        REQUIRE(sizes[0].bytes == 4096);
+        REQUIRE(sizes[1].bytes == 1000000);
+
+        REQUIRE(!(args["--weights"] | carp::list<double, 2>{}));
+        REQUIRE(!args.ok);
+    }
+
+    SECTION("Into the caller's storage, with ranges") {
+        char const *const argv[] = {"program", "--cpus=0-7,16-23,31", "--names=a,b,c"};
+        auto args = parser.parse(3, argv);
+
+        unsigned cpus[64];
+        auto const n = args["--cpus"].split(cpus, 64);
+        REQUIRE(n == 17u);
+        uint64_t mask = 0;
+        for (size_t i = 0; i < *n; ++i)
+            mask |= uint64_t{1} << cpus[i];
+        REQUIRE(mask == 0x80ff00ffu);
+
+        std::string_view names[3];
+        REQUIRE(args["--names"].split(names, 3) == 3u);
+        REQUIRE(names[2] == "c");
+        REQUIRE(args["--weights"].split(names, 3) == 0u);
+        REQUIRE(args.ok);
+
+        REQUIRE(!args["--cpus"].split(cpus, 16));
+        REQUIRE(!args.ok);
+    }
+
+    SECTION("Failures") {
+        for (char const *word : {"1,", ",1", "1,,2", "1;2", "a", "7-3", "1-", "1-2-3",
+                                 "0-4294967296", "-1"}) {
+            INFO(word);
+            char const *const argv[] = {"program", "--cpus", word};
+            unsigned cpus[64];
+            auto args = parser.parse(3, argv);
+            REQUIRE(!args["--cpus"].split(cpus, 64));
+            REQUIRE(!(args["--cpus"] | carp::list<unsigned, 64>{}));
+        }
+
+        /* signed ranges may start and end below zero */
+        int values[8];
+        char const *const argv[] = {"program", "--cpus", "-3--1,-1-1"};
+        REQUIRE(parser.parse(3, argv)["--cpus"].split(values, 8) == 6u);
+        REQUIRE(values[2] == -1);
+        REQUIRE(values[5] == 1);
+    }
+
+    SECTION("Long words are split where a character-wise search would") {
+        for (size_t length = 0; length < 80; ++length) {
+            for (size_t comma = 0; comma < length; ++comma) {
+                std::string word(length, 'x');
+                word[comma] = ',';
+                if (comma + 17 < length)
+                    word[comma + 17] = ',';
+
+                std::vector<std::string_view> expected;
+                for (size_t start = 0;;) {
+                    auto const end = std::min(word.find(',', start), word.size());
+                    expected.push_back(std::string_view(word).substr(start, end - start));
+                    if (end == word.size())
+                        break;
+                    start = end + 1;
+                }
+
+                std::vector<std::string_view> found;
+                std::string_view const words[] = {word};
+                bool const ok = carp::detail::split_list<std::string_view>(
+                    words[0], ',', [&](std::string_view w) {
+                        found.push_back(w);
+                        return true;
+                    });
+                REQUIRE(ok);
+                REQUIRE(found == expected);
+            }
+        }
+    }
+
+    SECTION("Split command lines") {
+        carp::token_buffer<4> tokens;
+        REQUIRE(tokens.split("program --cpus '2-4,9' trailing"));
+        auto args = parser.parse(3, tokens.data());
+        auto const cpus = *(args["--cpus"] | carp::list<int, 8>{});
+        REQUIRE(std::vector<int>(cpus.begin(), cpus.end()) ==
+                std::vector<int>{2, 3, 4, 9});
+    }
+}
+
 TEST_CASE("Parsing numbers", "[numeric]") {
     using carp::detail::str_to_num;
     using std::pair;
@@ -1144,4 +1423,1620 @@ TEST_CASE("Parsing numbers", "[numeric]") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Switch lookup", "[lookup]") {
+    using std::size;
+
+    static constexpr std::string_view names[] = {
+        "-a",      "-b",      "-c",       "-d",       "-e",        "-f",       "-g",
+        "-h",      "-i",      "-j",       "-k",       "-l",        "-m",       "-n",
+        "-o",      "-p",      "-q",       "-r",       "-s",        "-t",       "-ab",
+        "-ba",     "-abc",    "-acb",     "-bac",     "-bca",      "-cab",     "-cba",
+        "--a",     "--b",     "--ab",     "--ba",     "--alpha",   "--alphb",  "--alpha1",
+        "--beta",  "--betb",  "--gamma",  "--delta",  "--epsilon", "--zeta",   "--eta",
+        "--theta", "--iota",  "--kappa",  "--lambda", "--mu",      "--nu",     "--xi",
+        "--pi",    "--rho",   "--sigma",  "--tau",    "--phi",     "--chi",    "--psi",
+        "--omega", "-x-y-z",  "-X",       "-Y",       "-Z",        "-A1",      "-A2",
+    };
+    constexpr auto n = size(names);
+
+    std::vector<std::string> probes = {"", "-", "--", "---", "a", "-0", "--0"};
+    for (auto name : names) {
+        auto s = std::string(name);
+        probes.push_back(s);
+        probes.push_back(s + "x");
+        probes.push_back(s + s);
+        probes.push_back(s.substr(0, s.size() - 1));
+        probes.push_back("-" + s);
+    }
+
+    auto linear_find = [&](std::string_view word) {
+        return static_cast<size_t>(std::distance(
+            std::begin(names), std::find(std::begin(names), std::end(names), word)));
+    };
+
+    SECTION("perfect hash matches a linear search") {
+        constexpr auto key = [](size_t i) { return names[i]; };
+        constexpr auto table = carp::detail::perfect_hash<n>(n, key);
+        REQUIRE(table.perfect);
+
+        for (auto &p : probes)
+            REQUIRE(table.find(p, key) == linear_find(p));
+    }
+
+    SECTION("repeated names fall back to a linear search") {
+        static constexpr std::string_view repeated[] = {"-a", "-b", "-a", "-c"};
+        constexpr auto key = [](size_t i) { return repeated[i]; };
+        constexpr auto table = carp::detail::perfect_hash<size(repeated)>(size(repeated), key);
+        REQUIRE(!table.perfect);
+
+        REQUIRE(table.find("-a", key) == 0);
+        REQUIRE(table.find("-b", key) == 1);
+        REQUIRE(table.find("-c", key) == 3);
+        REQUIRE(table.find("-d", key) == size(repeated));
+    }
+
+    SECTION("parse finds the same switches as a linear search") {
+        constexpr auto parser = carp::parser({
+            {"pos", "a positional"},
+            {"-a", "a switch"},
+            {"-b", "a switch"},
+            {"-ab", "a switch"},
+            {"-ba", "a switch"},
+            {"--a", "a switch"},
+            {"--alpha", "a switch"},
+            {"--alphb", "a switch"},
+            {"--alpha1", "a switch"},
+            {"--omega", "a switch"},
+            {"-x-y-z", "a switch"},
+            {"-A1", "a switch"},
+        });
+        static constexpr std::string_view switches[] = {
+            "-a", "-b", "-ab", "-ba", "--a", "--alpha", "--alphb", "--alpha1", "--omega",
+            "-x-y-z", "-A1"};
+
+        for (auto &p : probes) {
+            if (p.size() < 2 || p[0] != '-' || (p[1] >= '0' && p[1] <= '9'))
+                continue;
+
+            char const *const argv[] = {"program", p.c_str()};
+            auto args = parser.parse(size(argv), argv);
+            if (p == "--") { /* the end of options */
+                REQUIRE(args.ok);
+                continue;
+            }
+
+            bool const known = std::find(std::begin(switches), std::end(switches), p) !=
+                               std::end(switches);
+            REQUIRE(args.ok == known);
+            REQUIRE(!!args[p] == known);
+            REQUIRE(!args["pos"]);
+        }
+    }
+}
+
+
+namespace resolved_ids {
+constexpr auto parser = carp::parser({
+    {"a", "'a', a positional argument"},
+    {"-s", "'s', a boolean switch"},
+    {"-t", "'t', a switch taking a string as an extra argument", 1},
+    {"-u", "'u', a switch taking two integers as extra arguments", 2},
+});
+
+struct known_name {
+    static constexpr std::string_view value = "-t";
+};
+struct misspelled_name {
+    static constexpr std::string_view value = "-tt";
+};
+
+template <typename Name, typename = void>
+constexpr bool resolves = false;
+
+template <typename Name>
+constexpr bool
+    resolves<Name, std::void_t<std::integral_constant<size_t, parser.id(Name::value).index>>> =
+        true;
+
+/* parsed_args refers to its parser, so a temporary one cannot parse */
+template <typename Parser, typename = void>
+constexpr bool parses = false;
+
+template <typename Parser>
+constexpr bool parses<Parser, std::void_t<decltype(std::declval<Parser>().parse(
+                                  0, static_cast<char const *const *>(nullptr)))>> = true;
+} // namespace resolved_ids
+
+TEST_CASE("Resolved argument ids", "[ids]") {
+    using resolved_ids::parser;
+    using std::size;
+
+    constexpr auto a = parser.id("a");
+    constexpr auto s = parser.id("-s");
+    constexpr auto t = parser.id("-t");
+    constexpr auto u = parser.id("-u");
+
+    static_assert(resolved_ids::resolves<resolved_ids::known_name>);
+    static_assert(!resolved_ids::resolves<resolved_ids::misspelled_name>);
+    using parser_type = std::remove_const_t<decltype(parser)>;
+    static_assert(resolved_ids::parses<parser_type const &>);
+    static_assert(!resolved_ids::parses<parser_type>);
+    static_assert(!resolved_ids::parses<parser_type const>);
+
+    SECTION("ids outlive the parser") {
+        auto const parse = [](char const *const *argv) {
+            auto const local = parser;
+            return local.parse(4, argv);
+        };
+        char const *const argv[] = {"program", "7", "-t", "x"};
+        auto args = parse(argv);
+        REQUIRE(args.ok);
+        REQUIRE(*(args[a] | 0) == 7);
+        REQUIRE(*(args[t] | "none") == "x"sv);
+    }
+
+    SECTION("all set") {
+        char const *const argv[] = {"program", "7", "-s", "-t", "x", "-u", "1", "2"};
+        auto args = parser.parse(size(argv), argv);
+
+        auto va = args[a] | 0;
+        auto vt = args[t] | "none";
+        auto vu = args[u] | std::array{0, 0};
+        REQUIRE(args.ok);
+        REQUIRE((va && *va == 7));
+        REQUIRE(args[s]);
+        REQUIRE((vt && *vt == "x"sv));
+        REQUIRE((vu && *vu == std::array{1, 2}));
+    }
+
+    SECTION("none set") {
+        char const *const argv[] = {"program"};
+        auto args = parser.parse(size(argv), argv);
+
+        auto va = args[a] | 3;
+        auto vt = args[t] | "none";
+        REQUIRE(args.ok);
+        REQUIRE((va && *va == 3));
+        REQUIRE(!args[s]);
+        REQUIRE((vt && *vt == "none"sv));
+        REQUIRE(!args[u]);
+    }
+
+    SECTION("unknown names at runtime are never set") {
+        char const *const argv[] = {"program", "7", "-s"};
+        auto args = parser.parse(size(argv), argv);
+
+        auto const unknown = std::string("-v");
+        REQUIRE(!args[parser.id(unknown)]);
+        REQUIRE(args[parser.id(std::string("-s"))]);
+    }
+}
+
+TEST_CASE("Integer decoding", "[integers]") {
+    auto decode = [](auto t, std::string const &s) {
+        using T = decltype(t);
+        return carp::detail::str_to_num<T>::get(s.data(), s.data() + s.size());
+    };
+
+    SECTION("Every length matches to_string") {
+        /* 1, 12, 123, ... up to 20 digits, so every partial chunk size is hit */
+        unsigned long long x = 0;
+        for (int digit = 1; digit <= 19; ++digit) {
+            x = x * 10 + static_cast<unsigned>(digit % 10);
+            auto const s = std::to_string(x);
+            REQUIRE(decode(0ull, s) == x);
+            REQUIRE(decode(0ll, "-" + s) == -static_cast<long long>(x));
+            REQUIRE(decode(0ull, "000" + s) == x);
+
+            for (size_t i = 0; i < s.size(); ++i) {
+                for (char bad : {'/', ':', 'a', ' ', '.', '\xb0'}) {
+                    auto mutated = s;
+                    mutated[i] = bad;
+                    REQUIRE(!decode(0ull, mutated));
+                }
+            }
+        }
+        REQUIRE(decode(0ull, "18446744073709551615") == 18446744073709551615ull);
+        REQUIRE(decode(0ull, "10000000000000000000") == 10000000000000000000ull);
+        REQUIRE(!decode(0ull, "18446744073709551616"));
+        REQUIRE(!decode(0ull, "99999999999999999999"));
+        REQUIRE(!decode(0ull, "100000000000000000000"));
+    }
+
+    SECTION("Types of up to 32 bits match from_chars") {
+        auto agrees = [&](auto t, std::string const &s) {
+            using T = decltype(t);
+            T expected{};
+            auto const end = s.data() + s.size();
+            auto const [ptr, ec] = std::from_chars(s.data(), end, expected);
+            auto const value = decode(t, s);
+            if (ec != std::errc{} || ptr != end)
+                return !value;
+            return value && *value == expected;
+        };
+        auto all_agree = [&](std::string const &s) {
+            INFO(s);
+            REQUIRE(agrees(signed_char{}, s));
+            REQUIRE(agrees(unsigned_char{}, s));
+            REQUIRE(agrees(short{}, s));
+            REQUIRE(agrees(unsigned_short{}, s));
+            REQUIRE(agrees(int{}, s));
+            REQUIRE(agrees(unsigned{}, s));
+        };
+
+        std::string s;
+        for (int digit = 1; digit <= 11; ++digit) {
+            s += static_cast<char>('0' + digit % 10);
+            for (auto const &v : {s, "-" + s, "0" + s, "-0" + s}) {
+                all_agree(v);
+                for (size_t i = 0; i < v.size(); ++i) {
+                    auto mutated = v;
+                    mutated[i] = ':';
+                    all_agree(mutated);
+                }
+            }
+        }
+        for (auto x : {"0", "-0", "", "-", "127", "-128", "128", "-129", "255", "256",
+                       "32767", "-32768", "65535", "65536", "999999999", "2147483647",
+                       "-2147483648", "2147483648", "4294967295", "4294967296"})
+            all_agree(x);
+    }
+
+    SECTION("Base prefixes") {
+        REQUIRE(decode(int{}, "0x7f") == 0x7f);
+        REQUIRE(decode(int{}, "0X7F") == 0x7f);
+        REQUIRE(decode(int{}, "0b101") == 5);
+        REQUIRE(decode(int{}, "0B101") == 5);
+        REQUIRE(decode(int{}, "0o17") == 15);
+        REQUIRE(decode(int{}, "0O17") == 15);
+        REQUIRE(decode(int{}, "-0x10") == -16);
+        REQUIRE(decode(signed_char{}, "-0x80") == -128);
+        REQUIRE(decode(0ull, "0xffffffffffffffff") == 0xffffffffffffffffull);
+
+        for (auto x : {"0x", "0b", "0o", "0b2", "0o8", "0xg", "-0x", "0x-1", "0x 1"})
+            REQUIRE(!decode(int{}, x));
+        REQUIRE(!decode(signed_char{}, "0x80"));
+        REQUIRE(!decode(unsigned{}, "-0x1"));
+        REQUIRE(!decode(0ull, "0x10000000000000000"));
+    }
+}
+
+TEST_CASE("Parsing floats without from_chars", "[floats]") {
+    /* str_to_num<T, int> is never specialized, so it is the fallback */
+    auto check = [](auto t, std::string const &s) {
+        using T = decltype(t);
+        auto const end = s.data() + s.size();
+        auto const fallback = carp::detail::str_to_num<T, int>::get(s.data(), end);
+        auto const expected = carp::detail::str_to_num<T>::get(s.data(), end);
+        INFO(s);
+        REQUIRE(!!fallback == !!expected);
+        if (expected && *expected == *expected)
+            REQUIRE(std::memcmp(&*fallback, &*expected, sizeof(T)) == 0);
+    };
+
+    uint64_t state = 88172645463325252u;
+    auto next = [&] {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        return state;
+    };
+
+    SECTION("Shortest and longer representations of random values") {
+        char buf[64];
+        for (int i = 0; i < 20000; ++i) {
+            auto const bits = next();
+            double d = 0;
+            float f = 0;
+            std::memcpy(&d, &bits, sizeof d);
+            std::memcpy(&f, &bits, sizeof f);
+            for (int precision : {6, 9, 17, 21, 30}) {
+                std::snprintf(buf, sizeof buf, "%.*g", precision, d);
+                check(double{}, buf);
+                check(float{}, buf);
+                std::snprintf(buf, sizeof buf, "%.*g", precision, static_cast<double>(f));
+                check(float{}, buf);
+            }
+        }
+    }
+
+    SECTION("Random digit strings") {
+        for (int i = 0; i < 50000; ++i) {
+            std::string s = next() % 2 ? "-" : "";
+            auto const n = 1 + next() % 24, point = next() % (n + 1);
+            for (size_t j = 0; j < n; ++j) {
+                if (j == point)
+                    s += '.';
+                s += static_cast<char>('0' + next() % 10);
+            }
+            s += 'e' + std::to_string(static_cast<int>(next() % 700) - 350);
+            check(double{}, s);
+            check(float{}, s);
+        }
+    }
+
+    SECTION("Boundaries") {
+        for (auto s : {"0", "-0", "0.000e999", "1", "1e23", "9007199254740993",
+                       "9007199254740992.5", "4.9406564584124654e-324",
+                       "2.4703282292062327e-324",
+                       "2.4703282292062328e-324", "2.2250738585072011e-308",
+                       "1.7976931348623157e308", "1.7976931348623158e308", "1.8e308",
+                       "1e-400", "3.4028235e38", "3.4028236e38", "1.4e-45", "7e-46",
+                       "1.17549435e-38", "0.1", "123456789012345678901234567890", "inf",
+                       "-Infinity", "nan", "nan(123)", "1.", ".1", "", ".", "e5", "1e", "+1",
+                       "0x1p3", "1,5", " 1", "1 "}) {
+            check(double{}, s);
+            check(float{}, s);
+        }
+    }
+}
+
+TEST_CASE("Batch parsing", "[batch]") {
+    constexpr auto parser = carp::parser({
+        {"a", "'a', a positional argument"},
+        {"b", "'b', a positional argument"},
+        {"-s", "'s', a boolean switch"},
+        {"-t", "'t', a switch taking a value", 1},
+        {"-u", "'u', a switch taking two values", 2},
+    });
+    constexpr size_t N = 5;
+
+    char const *const line0[] = {"program", "1", "-s", "2"};
+    char const *const line1[] = {"program", "-u", "3", "4", "5"};
+    char const *const line2[] = {"program", "-t", "x", "-v"};
+    char const *const line3[] = {"program"};
+    char const *const line4[] = {"program", "1", "2", "3"};
+    char const *const line5[] = {"program", "-t", "x", "-t", "y", "-u", "6"};
+
+    std::vector<std::pair<int, char const *const *>> lines = {
+        {4, line0}, {5, line1}, {4, line2}, {1, line3}, {4, line4}, {7, line5},
+    };
+
+    std::vector<uint64_t> present(lines.size());
+    std::vector<uint32_t> offsets(lines.size() * N), counts(lines.size() * N);
+    bool ok[6] = {};
+    decltype(parser)::parsed_batch batch{present.data(), offsets.data(), counts.data(), ok,
+                                         lines.size()};
+
+    REQUIRE(parser.parse_batch(lines, batch) == lines.size());
+
+    SECTION("Rows agree with parse") {
+        for (size_t row = 0; row < lines.size(); ++row) {
+            auto [argc, argv] = lines[row];
+            auto args = parser.parse(argc, argv);
+            auto unpacked = parser.unpack(batch, row, argv);
+            REQUIRE(batch.ok[row] == args.ok);
+            REQUIRE(unpacked.ok == args.ok);
+
+            for (auto name : {"a", "b", "-s", "-t", "-u"}) {
+                auto const id = parser.id(name);
+                REQUIRE(batch.has(row, id) == !!args[id]);
+                REQUIRE(!!unpacked[name] == !!args[name]);
+                if (args[id]) {
+                    REQUIRE((args[id] | carp::required<std::string_view>) ==
+                            (unpacked[id] | carp::required<std::string_view>));
+                }
+            }
+        }
+    }
+
+    SECTION("Columns") {
+        auto const u = parser.id("-u"), t = parser.id("-t");
+        REQUIRE(batch.has(1, u));
+        REQUIRE(batch.offsets[1 * N + u.index] == 2);
+        REQUIRE(batch.counts[1 * N + u.index] == 2);
+        REQUIRE(!batch.ok[2]);
+        REQUIRE(!batch.ok[4]);
+        REQUIRE(present[3] == 0);
+
+        /* the last occurrence wins, as with parse */
+        REQUIRE(batch.offsets[5 * N + t.index] == 4);
+        REQUIRE(batch.counts[5 * N + u.index] == 1);
+    }
+
+    SECTION("Output is never overrun") {
+        batch.rows = 2;
+        REQUIRE(parser.parse_batch(lines, batch) == 2);
+    }
+
+    SECTION("More than 64 arguments") {
+        static char names[70][8];
+        carp::parser<70>::arg table[70];
+        for (size_t i = 0; i < 70; ++i) {
+            std::snprintf(names[i], sizeof names[i], "-s%zu", i);
+            table[i] = {names[i], "a switch"};
+        }
+        auto const wide = carp::parser<70>(table);
+
+        char const *const line[] = {"program", "-s3", "-s69", "-s64"};
+        std::pair<int, char const *const *> const wide_lines[] = {{4, line}};
+        uint64_t wide_present[2];
+        uint32_t wide_offsets[70], wide_counts[70];
+        bool wide_ok;
+        carp::parser<70>::parsed_batch wide_batch{wide_present, wide_offsets, wide_counts,
+                                                  &wide_ok, 1};
+
+        REQUIRE(wide.parse_batch(wide_lines, wide_batch) == 1);
+        REQUIRE(wide_ok);
+        REQUIRE(wide_present[0] == uint64_t(1) << 3);
+        REQUIRE(wide_present[1] == (uint64_t(1) << 5 | uint64_t(1)));
+        REQUIRE(wide_batch.has(0, wide.id("-s69")));
+        REQUIRE(wide_offsets[wide.id("-s64").index] == 3);
+    }
+}
+
+TEST_CASE("Command line strings", "[cmdline]") {
+    auto split = [](std::string_view cmdline) {
+        carp::token_buffer<16, 32> tokens;
+        std::vector<std::string> words;
+        if (!tokens.split(cmdline))
+            return std::optional<std::vector<std::string>>{};
+        for (auto w : tokens)
+            words.emplace_back(w);
+        return std::optional{words};
+    };
+    using words = std::vector<std::string>;
+
+    SECTION("Splitting") {
+        REQUIRE(split("") == words{});
+        REQUIRE(split(" \t\n ") == words{});
+        REQUIRE(split("program  1 -s\t2\n") == words{"program", "1", "-s", "2"});
+        REQUIRE(split("a 'b c' \"d e\" f\\ g") == words{"a", "b c", "d e", "f g"});
+        REQUIRE(split("--x=\"a b\" '' \"\"") == words{"--x=a b", "", ""});
+        REQUIRE(split(R"("a\"b" "a\$b\`c\\d" "a\qb" 'a\qb')") ==
+                words{"a\"b", "a$b`c\\d", "a\\qb", "a\\qb"});
+        REQUIRE(split(R"('it'\''s')") == words{"it's"});
+        REQUIRE(split("ab\\\ncd \"ef\\\ngh\"") == words{"abcd", "efgh"});
+        auto const proc_cmdline = std::string_view("program\0-t\0x\0", 14);
+        REQUIRE(split(proc_cmdline) == words{"program", "-t", "x"});
+    }
+
+    SECTION("Split on NUL alone") {
+        auto split0 = [](std::string_view text) {
+            carp::token_buffer<8> tokens;
+            REQUIRE(tokens.split(text, carp::nul_delimited));
+            return words(tokens.begin(), tokens.end());
+        };
+        /* /proc/<pid>/cmdline of: prog -t 'v a' "'q' \"r\"\\s" '' */
+        auto const cmdline = "prog\0-t\0v a\0'q' \"r\"\\s\0\0"sv;
+        REQUIRE(split0(cmdline) == words{"prog", "-t", "v a", "'q' \"r\"\\s", ""});
+        REQUIRE(split0("a\0\0b"sv) == words{"a", "", "b"});
+        REQUIRE(split0("") == words{});
+
+        carp::token_buffer<4> tokens;
+        REQUIRE(!tokens.split("a\0b\0c\0d\0e"sv, carp::nul_delimited));
+
+        constexpr auto parser = carp::parser({
+            {"-t", "'t', a switch taking a string", 1},
+            {"-s", "'s', a boolean switch"},
+        });
+        auto args = parser.parse("prog\0-t\0'a b'\0-s\0"sv, tokens, carp::nul_delimited);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["-t"] | carp::required<std::string_view>) == "'a b'");
+        REQUIRE(args["-s"]);
+    }
+
+    SECTION("Malformed or too long") {
+        for (auto cmdline : {"a 'b", "a \"b", "a b\\", "a \"b\\",
+                             "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17",
+                             "--x='a b c d e f g h i j k l m n o'"})
+            REQUIRE(!split(cmdline));
+
+        /* joined words share 32 characters, single pieces take none */
+        REQUIRE(split("--x='a b c d e f g h i j k l m n'"));
+        REQUIRE(split("'a b c d e f g h i j k l m n o p q r s t u v w x y z'"));
+    }
+
+    SECTION("Words are views of the string unless joined") {
+        std::string_view const cmdline = "program 'a b' \"c d\" plain e\\ f \"g\\\\h\"";
+        carp::token_buffer<8> tokens;
+        REQUIRE(tokens.split(cmdline));
+        REQUIRE(tokens.size() == 6);
+
+        auto inside = [&](std::string_view w) {
+            return w.data() >= cmdline.data() &&
+                   w.data() + w.size() <= cmdline.data() + cmdline.size();
+        };
+        REQUIRE(inside(tokens[0]));
+        REQUIRE(inside(tokens[1]));
+        REQUIRE(inside(tokens[2]));
+        REQUIRE(inside(tokens[3]));
+        REQUIRE(!inside(tokens[4]));
+        REQUIRE(tokens[5] == "g\\h");
+    }
+
+    SECTION("Parsing") {
+        constexpr auto parser = carp::parser({
+            {"a", "'a', an integer"},
+            {"b", "'b', a string"},
+            {"-s", "'s', a boolean switch"},
+            {"-u", "'u', a switch taking two doubles", 2},
+            {"-w", "'w', a switch taking a string, an integer and a double", 3},
+        });
+        carp::token_buffer<16> tokens;
+
+        auto args =
+            parser.parse("program 12 'two words' -u 1.5 -2e3 -w \"x y\" 7 0.25 -s", tokens);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["a"] | carp::required<int>) == 12);
+        REQUIRE(*(args["b"] | carp::required<std::string_view>) == "two words");
+        REQUIRE(args["-s"]);
+        REQUIRE(*(args["-u"] | carp::required<std::array<double, 2>>) ==
+                std::array{1.5, -2e3});
+        REQUIRE(*(args["-w"] | carp::required<std::tuple<std::string_view, int, double>>) ==
+                std::tuple{"x y"sv, 7, 0.25});
+
+        /* words of a string are not null-terminated, even with a default */
+        REQUIRE(*(args["b"] | "none"sv) == "two words");
+        REQUIRE(args.ok);
+        REQUIRE(!(args["b"] | "none"));
+        REQUIRE(!args.ok);
+        args.ok = true;
+        REQUIRE(!(args["b"] | carp::required<char const *>));
+        REQUIRE(!args.ok);
+
+        REQUIRE(!parser.parse("program 1 -x", tokens).ok);
+        REQUIRE(!parser.parse("program 'unterminated", tokens).ok);
+    }
+
+    SECTION("Numbers from ranges") {
+        using long_double_fallback = carp::detail::str_to_num<long double, int>;
+        std::string_view const digits = "12345.5e1";
+        for (size_t n = 1; n <= digits.size(); ++n) {
+            auto const sub = digits.substr(0, n);
+            auto const end = sub.data() + sub.size();
+            auto const expected = std::strtold(std::string(sub).c_str(), nullptr);
+            auto const fallback = long_double_fallback::get(sub.data(), end);
+            REQUIRE((n == 8) != (fallback && *fallback == expected));
+        }
+        std::string const huge(200, '1');
+        REQUIRE(long_double_fallback::get(huge.data(), huge.data() + huge.size()));
+        REQUIRE(!long_double_fallback::get(" 1"sv.data(), " 1"sv.data() + 2));
+    }
+}
+
+TEST_CASE("Response files", "[response]") {
+    constexpr auto parser = carp::parser({
+        {"a", "'a', an integer"},
+        {"-s", "'s', a boolean switch"},
+        {"-t", "'t', a switch taking a string", 1},
+        {"-n", "'n', a switch taking an integer", 1},
+    });
+
+    auto const dir = std::filesystem::temp_directory_path();
+    auto write = [&](std::string const &name, std::string const &text) {
+        auto const path = (dir / ("carp_test_" + name)).string();
+        std::ofstream(path, std::ios::binary) << text;
+        return "@" + path;
+    };
+
+    auto const inner = write("inner", "-n 42\n");
+    auto const outer = write("outer", "-t 'a b'\n" + inner + "\n7\n");
+    auto const empty = write("empty", "");
+    auto const self = write("self", "@" + (dir / "carp_test_self").string());
+    auto const unterminated = write("unterminated", "-t 'a b");
+
+    auto arena = std::make_unique<carp::response_arena<64, 64, 4>>();
+
+    SECTION("Expanded in place") {
+        char const *const argv[] = {"program", outer.c_str(), "-s", empty.c_str()};
+        auto args = parser.parse(4, argv, *arena);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["-t"] | carp::required<std::string_view>) == "a b");
+        REQUIRE(*(args["-n"] | carp::required<int>) == 42);
+        REQUIRE(*(args["a"] | carp::required<int>) == 7);
+        REQUIRE(args["-s"]);
+        REQUIRE(arena->size() == 7);
+
+        /* words are views, strings unwrap as std::string_view */
+        REQUIRE(*(args["-t"] | "none"sv) == "a b");
+        REQUIRE(args.ok);
+        REQUIRE(!(args["-t"] | "none"));
+        REQUIRE(!args.ok);
+    }
+
+    SECTION("Not expanded") {
+        char const *const argv[] = {"@program", "@"};
+        REQUIRE(arena->expand(2, argv));
+        REQUIRE(arena->size() == 2);
+        REQUIRE((*arena)[0] == "@program");
+        REQUIRE((*arena)[1] == "@");
+    }
+
+    SECTION("Failures") {
+        auto const missing = "@" + (dir / "carp_test_missing").string();
+        for (auto const &file : {missing, self, unterminated}) {
+            char const *const argv[] = {"program", file.c_str()};
+            REQUIRE(!parser.parse(2, argv, *arena).ok);
+        }
+
+        /* more files than the arena holds */
+        char const *const argv[] = {"program", inner.c_str(), inner.c_str(), inner.c_str(),
+                                    inner.c_str(), inner.c_str()};
+        REQUIRE(!parser.parse(6, argv, *arena).ok);
+        REQUIRE(parser.parse(5, argv, *arena).ok);
+    }
+
+    SECTION("Long files") {
+        std::string text;
+        for (int i = 0; i < 100000; ++i)
+            text += "-n " + std::to_string(i) + (i % 2 ? "\n" : " ");
+        auto const big = write("big", text);
+
+        /* mapped files take no characters from the arena */
+        constexpr size_t chars = CARP_HAS_MMAP ? 0 : 1 << 21;
+        auto big_arena = std::make_unique<carp::response_arena<200001, chars, 1>>();
+        char const *const argv[] = {"program", big.c_str()};
+        auto args = parser.parse(2, argv, *big_arena);
+        REQUIRE(args.ok);
+        REQUIRE(big_arena->size() == 200001);
+        REQUIRE(*(args["-n"] | carp::required<int>) == 99999);
+
+        REQUIRE(!parser.parse(2, argv, *arena).ok);
+    }
+
+#if CARP_HAS_UNISTD
+    SECTION("Pipes") {
+        /* as in tool @<(echo -n 42): nothing to map, so read into the arena */
+        auto piped = [&](std::string const &text) {
+            int fds[2];
+            REQUIRE(::pipe(fds) == 0);
+            REQUIRE(::write(fds[1], text.data(), text.size()) ==
+                    static_cast<ssize_t>(text.size()));
+            ::close(fds[1]);
+            auto const path = "@/dev/fd/" + std::to_string(fds[0]);
+            char const *const argv[] = {"program", path.c_str()};
+            auto const ok = arena->expand(2, argv);
+            ::close(fds[0]);
+            return ok;
+        };
+
+        REQUIRE(piped("-n 42 -t 'a b'\n"));
+        auto args = parser.parse(static_cast<int>(arena->size()), arena->data());
+        REQUIRE(args.ok);
+        REQUIRE(*(args["-n"] | carp::required<int>) == 42);
+        REQUIRE(*(args["-t"] | carp::required<std::string_view>) == "a b");
+
+        REQUIRE(!piped(std::string(65, 'x')));
+    }
+#endif
+
+#ifdef __linux__
+    SECTION("Regular files without a size") {
+        /* /proc files read as size 0, so they are read rather than mapped */
+        std::string first;
+        std::getline(std::ifstream("/proc/self/cmdline"), first, '\0');
+        auto proc_arena = std::make_unique<carp::response_arena<64, 4096, 1>>();
+        char const *const argv[] = {"program", "@/proc/self/cmdline"};
+        REQUIRE(proc_arena->expand(2, argv));
+        REQUIRE(proc_arena->size() >= 2);
+        REQUIRE((*proc_arena)[1] == first);
+    }
+#endif
+}
+
+TEST_CASE("Environment variables", "[env]") {
+    constexpr auto parser = carp::parser({
+        {"a", "'a', an integer", 0, "CARP_A"},
+        {"-s", "'s', a boolean switch", 0, "CARP_S"},
+        {"-t", "'t', a switch taking a string", 1, "CARP_T"},
+        {"-n", "'n', a switch taking an integer", 1},
+    });
+    char const *const envp[] = {"PATH=/bin",  "CARP_T=from env", "CARP_A=7", "CARP_S=",
+                                "CARP_A=8",   "CARP_N=3",        "CARP",     "=x",
+                                "CARP_T2=no", nullptr};
+
+    SECTION("Read by id once the parser is gone") {
+        constexpr auto t = parser.id("-t");
+        auto const parse = [&](char const *const *argv) {
+            auto const local = parser;
+            return local.parse(1, argv, envp);
+        };
+        char const *const argv[] = {"program"};
+        auto args = parse(argv);
+        REQUIRE(*(args[t] | carp::required<std::string_view>) == "from env");
+    }
+
+    SECTION("Missing arguments") {
+        char const *const argv[] = {"program"};
+        auto args = parser.parse(1, argv, envp);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["a"] | carp::required<int>) == 7);
+        REQUIRE(*(args["-t"] | carp::required<std::string_view>) == "from env");
+        auto const t = args["-t"] | carp::required<char const *>;
+        REQUIRE(std::strcmp(*t, "from env") == 0);
+        REQUIRE(args["-s"]);
+        REQUIRE(!args["-n"]);
+    }
+
+    SECTION("The command line takes priority") {
+        char const *const argv[] = {"program", "5", "-t", "from argv"};
+        auto args = parser.parse(4, argv, envp);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["a"] | carp::required<int>) == 5);
+        REQUIRE(*(args["-t"] | carp::required<std::string_view>) == "from argv");
+        REQUIRE(args["-s"]);
+    }
+
+    SECTION("Bad values") {
+        char const *const argv[] = {"program"};
+        char const *const bad[] = {"CARP_A=x", nullptr};
+        auto args = parser.parse(1, argv, bad);
+        REQUIRE(!(args["a"] | carp::required<int>));
+        REQUIRE(!args.ok);
+    }
+
+    SECTION("Boolean switches, as in config files") {
+        char const *const argv[] = {"program"};
+        for (auto on : {"CARP_S=", "CARP_S=true"}) {
+            char const *const env[] = {on, nullptr};
+            auto args = parser.parse(1, argv, env);
+            REQUIRE(args.ok);
+            REQUIRE(args["-s"]);
+        }
+
+        char const *const off[] = {"CARP_S=false", nullptr};
+        auto args = parser.parse(1, argv, off);
+        REQUIRE(args.ok);
+        REQUIRE(!args["-s"]);
+
+        for (auto bad : {"CARP_S=0", "CARP_S=yes", "CARP_S=true "}) {
+            INFO(bad);
+            char const *const env[] = {bad, "CARP_A=3", nullptr};
+            auto args = parser.parse(1, argv, env);
+            REQUIRE(!args.ok);
+            REQUIRE(!args["-s"]);
+            REQUIRE(*(args["a"] | 0) == 3);
+        }
+    }
+
+    SECTION("No environment") {
+        char const *const argv[] = {"program"};
+        char const *const none[] = {nullptr};
+        for (auto e : {none, static_cast<char const *const *>(nullptr)}) {
+            auto args = parser.parse(1, argv, e);
+            REQUIRE(args.ok);
+            REQUIRE(!args["a"]);
+            REQUIRE(!args["-s"]);
+        }
+    }
+
+    SECTION("Many variables") {
+        constexpr size_t n = 200;
+        std::vector<std::string> names, entries;
+        for (size_t i = 0; i < n; ++i)
+            names.push_back("-o" + std::to_string(i));
+        carp::parser<n>::arg table[n];
+        for (size_t i = 0; i < n; ++i)
+            table[i] = {names[i], "", 1, std::string_view(names[i]).substr(1)};
+        auto const many = std::make_unique<carp::parser<n>>(table);
+
+        for (size_t i = 0; i < n; i += 3)
+            entries.push_back(names[i].substr(1) + "=" + std::to_string(i));
+        std::vector<char const *> env;
+        for (auto &e : entries)
+            env.push_back(e.c_str());
+        env.push_back(nullptr);
+
+        char const *const argv[] = {"program", "-o0", "-1"};
+        auto args = many->parse(3, argv, env.data());
+        REQUIRE(args.ok);
+        for (size_t i = 0; i < n; ++i) {
+            auto const value = args[names[i]];
+            REQUIRE(!!value == (i % 3 == 0));
+            if (value)
+                REQUIRE(*(value | 0) == (i ? int(i) : -1));
+        }
+    }
+}
+
+TEST_CASE("Config files", "[config]") {
+    static constexpr auto parser = carp::parser({
+        {"file", "the input"},
+        {"--threads", "number of threads", 1, "CARP_THREADS"},
+        {"--name", "a name", 1},
+        {"--size", "width and height", 2},
+        {"--verbose", "a boolean switch"},
+        {"--quiet", "another boolean switch"},
+        {"-j", "jobs", 1},
+    });
+
+    auto const dir = std::filesystem::temp_directory_path();
+    auto write = [&](std::string const &name, std::string const &text) {
+        auto const path = (dir / ("carp_test_" + name)).string();
+        std::ofstream(path, std::ios::binary) << text;
+        return path;
+    };
+
+    auto const settings = write("settings.conf", "# service settings\n"
+                                                 "threads = 8\n"
+                                                 "\n"
+                                                 "  name=primary east  \r\n"
+                                                 "size = 640\t480\n"
+                                                 "verbose\n"
+                                                 "quiet = false\n"
+                                                 "j = 3");
+
+    auto config = std::make_unique<carp::config_file<16>>();
+
+    SECTION("Merged under argv") {
+        REQUIRE(config->open(settings));
+        char const *const argv[] = {"program", "input", "-j", "5"};
+        auto args = parser.parse(4, argv, *config);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["file"] | carp::required<std::string_view>) == "input");
+        REQUIRE(*(args["--threads"] | 1) == 8);
+        REQUIRE(*(args["-j"] | 1) == 5);
+        REQUIRE(*(args["--size"] | carp::required<std::array<int, 2>>) ==
+                std::array{640, 480});
+        REQUIRE(args["--verbose"]);
+        REQUIRE(!args["--quiet"]);
+        REQUIRE(args.count("--threads") == 1);
+
+        /* values are views of the mapped file */
+        auto const name = *(args["--name"] | carp::required<std::string_view>);
+        REQUIRE(name == "primary east");
+        auto const text = config->contents();
+        REQUIRE(name.data() >= text.data());
+        REQUIRE(name.data() + name.size() <= text.data() + text.size());
+
+        /* so they are not null-terminated, and take no char const * default */
+        REQUIRE(*(args["--name"] | "none"sv) == "primary east");
+        REQUIRE(args.ok);
+        REQUIRE(!(args["--name"] | "none"));
+        REQUIRE(!args.ok);
+    }
+
+    SECTION("Argv, then the environment, then the file") {
+        REQUIRE(config->open(settings));
+        char const *const envp[] = {"CARP_THREADS=12", nullptr};
+        char const *const argv[] = {"program", "--size", "1", "2"};
+        auto args = parser.parse(4, argv, envp);
+        parser.parse_config(args, *config);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--threads"] | 1) == 12);
+        REQUIRE(*(args["--size"] | std::array{0, 0}) == std::array{1, 2});
+        REQUIRE(*(args["-j"] | 1) == 3);
+    }
+
+    SECTION("Text in memory, first lines first") {
+        config->assign("threads = 2\nthreads = 3\nverbose = true\n\n#j = 9\n");
+        char const *const argv[] = {"program"};
+        auto args = parser.parse(1, argv, *config);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--threads"] | 1) == 2);
+        REQUIRE(args["--verbose"]);
+        REQUIRE(!args["-j"]);
+
+        config->assign("");
+        REQUIRE(parser.parse(1, argv, *config).ok);
+    }
+
+    SECTION("Parses share the file, not their values") {
+        config->assign("size = 640 480\nname = east\n");
+        char const *const sized[] = {"program", "--size", "1", "2"};
+        char const *const plain[] = {"program"};
+        auto a = parser.parse(4, sized, *config);
+        auto b = parser.parse(1, plain, *config);
+        REQUIRE(a.ok);
+        REQUIRE(b.ok);
+        REQUIRE(*(a["--name"] | carp::required<std::string_view>) == "east");
+        REQUIRE(*(a["--size"] | std::array{0, 0}) == std::array{1, 2});
+        REQUIRE(*(b["--name"] | carp::required<std::string_view>) == "east");
+        REQUIRE(*(b["--size"] | std::array{0, 0}) == std::array{640, 480});
+    }
+
+    SECTION("Failures leave the other lines") {
+        char const *const argv[] = {"program"};
+        for (std::string_view bad :
+             {"thread = 1", "--threads = 1", "= 1", "size = 1", "size = 1 2 3", "name =",
+              "name", "verbose = yes", "verbose = true false", "file = x"}) {
+            INFO(bad);
+            auto const text = "j = 4\n" + std::string(bad) + "\nthreads = 6\n";
+            config->assign(text);
+            auto args = parser.parse(1, argv, *config);
+            REQUIRE(!args.ok);
+            REQUIRE(*(args["-j"] | 1) == 4);
+            REQUIRE(*(args["--threads"] | 1) == 6);
+        }
+
+        carp::config_file<2> small;
+        small.assign("j = 4\nsize = 1 2\n");
+        REQUIRE(!parser.parse(1, argv, small).ok);
+        small.assign("size = 1 2\nj = 4\n");
+        REQUIRE(!parser.parse(1, argv, small).ok);
+        small.assign("size = 1 2\nverbose\n");
+        REQUIRE(parser.parse(1, argv, small).ok);
+
+        /* whole-line words count against the room too */
+        carp::config_file<4, 64> even;
+        even.assign("size = 1 2\nsize = 3 4\nsize = 5 6\n");
+        auto args = parser.parse(1, argv, even);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--size"] | std::array{0, 0}) == std::array{1, 2});
+        even.assign("j = 7\nsize = 1 2\nname = a b\n");
+        args = parser.parse(1, argv, even);
+        REQUIRE(!args.ok);
+        REQUIRE(*(args["-j"] | 1) == 7);
+        REQUIRE(!args["--name"]);
+
+        REQUIRE(!config->open((dir / "carp_test_missing").string()));
+    }
+
+    SECTION("Long files") {
+        std::string text;
+        for (int i = 0; i < 100000; ++i)
+            text += "# comment " + std::to_string(i) + "\n";
+        text += "threads = 99999";
+        auto const big = write("big.conf", text);
+
+        /* mapped files take no characters from the config_file */
+        constexpr size_t chars = CARP_HAS_MMAP ? 0 : 1 << 21;
+        auto big_config = std::make_unique<carp::config_file<16, chars>>();
+        REQUIRE(big_config->open(big));
+        REQUIRE(!config->open(big) == !CARP_HAS_MMAP);
+        char const *const argv[] = {"program"};
+        auto args = parser.parse(1, argv, *big_config);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--threads"] | 1) == 99999);
+    }
+
+#if CARP_HAS_UNISTD
+    SECTION("Pipes") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        std::string const text = "threads = 4\nname = from a pipe\n";
+        REQUIRE(::write(fds[1], text.data(), text.size()) ==
+                static_cast<ssize_t>(text.size()));
+        ::close(fds[1]);
+        auto const opened = config->open("/dev/fd/" + std::to_string(fds[0]));
+        ::close(fds[0]);
+        REQUIRE(opened);
+
+        char const *const argv[] = {"program"};
+        auto args = parser.parse(1, argv, *config);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--threads"] | 1) == 4);
+        REQUIRE(*(args["--name"] | carp::required<std::string_view>) == "from a pipe");
+    }
+#endif
+
+#ifdef __linux__
+    SECTION("Regular files without a size") {
+        REQUIRE(config->open("/proc/self/status"));
+        REQUIRE(config->contents().substr(0, 5) == "Name:");
+    }
+#endif
+}
+
+TEST_CASE("Subcommands", "[commands]") {
+    static constexpr auto tool = carp::commands(
+        carp::command("run", carp::parser({
+                                 {"target", "what to run"},
+                                 {"-j", "number of jobs", 1},
+                             })),
+        carp::command("stat", carp::parser({{"-v", "verbose"}})),
+        carp::command("gc", carp::parser({{"--aggressive", "optimize harder"}})));
+
+    static_assert(tool.size == 3);
+    static_assert(tool.index("stat") == 1 && tool.find("status") == tool.size);
+
+    auto run = [](int argc, char const *const *argv) {
+        return tool.parse(argc, argv, [](auto command, auto &args) {
+            if constexpr (command == tool.index("run"))
+                return *(args["target"] | ""sv) == "tests" && *(args["-j"] | 1) == 8 &&
+                       args.ok;
+            else if constexpr (command == tool.index("stat"))
+                return args["-v"] && args.ok;
+            else
+                return args.ok;
+        });
+    };
+
+    SECTION("Dispatch") {
+        char const *const run_argv[] = {"tool", "run", "tests", "-j", "8"};
+        char const *const stat_argv[] = {"tool", "stat", "-v"};
+        char const *const gc_argv[] = {"tool", "gc"};
+        REQUIRE(run(5, run_argv) == true);
+        REQUIRE(run(3, stat_argv) == true);
+        REQUIRE(run(2, gc_argv) == true);
+    }
+
+    SECTION("Each command has its own options") {
+        char const *const argv[] = {"tool", "stat", "-j", "8"};
+        REQUIRE(run(4, argv) == false);
+        char const *const gc_argv[] = {"tool", "gc", "now"};
+        REQUIRE(run(3, gc_argv) == false);
+    }
+
+    SECTION("Missing or unknown commands") {
+        char const *const argv[] = {"tool", "status", "-v"};
+        REQUIRE(!run(3, argv));
+        REQUIRE(!run(1, argv));
+    }
+
+    SECTION("Handlers returning void") {
+        std::string seen;
+        std::string_view const argv[] = {"tool", "gc"};
+        REQUIRE(tool.parse(2, argv, [&](auto command, auto &) {
+            seen = tool.name(command);
+        }));
+        REQUIRE(seen == "gc");
+        REQUIRE(!tool.parse(1, argv, [&](auto, auto &) { seen.clear(); }));
+        REQUIRE(seen == "gc");
+    }
+}
+
+namespace {
+struct config {
+    int a = 0;
+    std::string b = "zebra";
+    bool s = false;
+    std::string_view t = "none";
+    std::array<int, 2> u{};
+    bool verbose = true;
+    double d = 1.5;
+};
+} // namespace
+
+TEST_CASE("Binding to a struct", "[bind]") {
+    static constexpr auto parser = carp::parser({
+        {"a", "'a', an integer"},
+        {"b", "'b', a string"},
+        {"-s", "'s', a boolean switch"},
+        {"-t", "'t', a switch taking a string", 1},
+        {"-u", "'u', a switch taking two integers", 2},
+        {"-v", "'v', a switch taking a boolean", 1},
+        {"-d", "'d', a switch taking a double, left unbound", 1},
+    });
+    static constexpr auto cli = parser.bind(
+        carp::field<&config::a>("a"), carp::field<&config::b>("b"),
+        carp::field<&config::s>("-s"), carp::field<&config::t>("-t"),
+        carp::field<&config::u>("-u"), carp::field<&config::verbose>("-v"));
+
+    SECTION("Every member") {
+        char const *const argv[] = {"program", "-u", "1", "2", "12", "-t", "x",
+                                    "gasket",  "-s", "-v", "0", "-d", "9"};
+        config cfg;
+        auto const res = cli.parse_into(13, argv, cfg);
+        REQUIRE(res.ok);
+        REQUIRE(cfg.a == 12);
+        REQUIRE(cfg.b == "gasket");
+        REQUIRE(cfg.s);
+        REQUIRE(cfg.t == "x");
+        REQUIRE(cfg.u == std::array{1, 2});
+        REQUIRE(!cfg.verbose);
+        REQUIRE(cfg.d == 1.5);
+    }
+
+    SECTION("Absent arguments keep their member") {
+        char const *const argv[] = {"program", "7"};
+        config cfg;
+        REQUIRE(cli.parse_into(2, argv, cfg).ok);
+        REQUIRE(cfg.a == 7);
+        REQUIRE(cfg.b == "zebra");
+        REQUIRE(!cfg.s);
+        REQUIRE(cfg.t == "none");
+        REQUIRE(cfg.verbose);
+    }
+
+    SECTION("Failures") {
+        std::string_view const argv[] = {"program", "x", "-u", "1", "-z"};
+        config cfg;
+        auto const res = cli.parse_into(5, argv, cfg);
+        REQUIRE(!res.ok);
+        REQUIRE(res.has(parser.id("a")));
+        REQUIRE(res.has(parser.id("-u")));
+        REQUIRE(!res.has(parser.id("b")));
+        REQUIRE(!res.has(parser.id("-s")));
+        REQUIRE(cfg.a == 0);
+
+        /* unknown words fail without a member to blame */
+        char const *const unknown[] = {"program", "-z"};
+        auto const other = cli.parse_into(2, unknown, cfg);
+        REQUIRE(!other.ok);
+        REQUIRE(other.failed == decltype(other.failed){});
+    }
+
+    SECTION("Agrees with parsed_args") {
+        char const *const argv[] = {"program", "-t", "y", "3", "-u", "4", "5", "word"};
+        config cfg;
+        REQUIRE(cli.parse_into(8, argv, cfg).ok);
+        auto args = parser.parse(8, argv);
+        REQUIRE(*(args["a"] | 0) == cfg.a);
+        REQUIRE(*(args["b"] | std::string()) == cfg.b);
+        REQUIRE(*(args["-t"] | ""sv) == cfg.t);
+        REQUIRE(*(args["-u"] | std::array{0, 0}) == cfg.u);
+    }
+}
+
+TEST_CASE("Clustered short switches", "[clusters]") {
+    static constexpr auto parser = carp::parser({
+        {"a", "'a', an integer"},
+        {"-x", "'x', a boolean switch"},
+        {"-v", "'v', a boolean switch"},
+        {"-f", "'f', a boolean switch"},
+        {"-j", "'j', a switch taking an integer", 1},
+        {"-u", "'u', a switch taking two integers", 2},
+        {"-xv", "a switch whose name looks like a cluster"},
+        {"--long", "a long switch"},
+    });
+    static constexpr auto flags = parser.mask({"-x", "-v", "-f"});
+
+    /* the result refers to words, until the next call */
+    std::vector<char const *> words;
+    auto parse = [&](std::vector<char const *> const &argv) {
+        words = {"program"};
+        words.insert(words.end(), argv.begin(), argv.end());
+        return parser.parse(static_cast<int>(words.size()), words.data());
+    };
+
+    SECTION("Flags") {
+        auto args = parse({"-fvx"});
+        REQUIRE(args.ok);
+        REQUIRE(args["-x"]);
+        REQUIRE(args["-v"]);
+        REQUIRE(args["-f"]);
+        REQUIRE(!args["-xv"]);
+        REQUIRE(args.present().all(flags));
+
+        auto some = parse({"-vf", "3"});
+        REQUIRE(some.ok);
+        REQUIRE(*(some["a"] | 0) == 3);
+        REQUIRE(!some.present().all(flags));
+        REQUIRE(some.present().any(flags));
+        REQUIRE(!parse({"3"}).present().any(flags));
+    }
+
+    SECTION("Names take priority") {
+        auto args = parse({"-xv"});
+        REQUIRE(args.ok);
+        REQUIRE(args["-xv"]);
+        REQUIRE(!args["-x"]);
+        REQUIRE(!args["-v"]);
+    }
+
+    SECTION("Attached values") {
+        for (auto const &argv : std::vector<std::vector<char const *>>{
+                 {"-j8"}, {"-xj8"}, {"-xj", "8"}, {"-j", "8"}, {"-vfj8", "-x"}}) {
+            auto args = parse(argv);
+            REQUIRE(args.ok);
+            REQUIRE(*(args["-j"] | carp::required<int>) == 8);
+            REQUIRE(*(args["-j"] | carp::required<std::string_view>) == "8");
+            REQUIRE(std::strcmp(*(args["-j"] | carp::required<char const *>), "8") == 0);
+        }
+        auto args = parse({"-j-5", "-xu", "1", "2", "7"});
+        REQUIRE(args.ok);
+        REQUIRE(*(args["-j"] | 0) == -5);
+        REQUIRE(*(args["-u"] | std::array{0, 0}) == std::array{1, 2});
+        REQUIRE(*(args["a"] | 0) == 7);
+    }
+
+    SECTION("Failures") {
+        for (auto const &argv : std::vector<std::vector<char const *>>{
+                 {"-xq"}, {"-u1", "2"}, {"--xv"}, {"--long=1"}, {"-x5"}})
+            REQUIRE(!parse(argv).ok);
+        REQUIRE(parse({"-5"}).ok);
+
+        /* a cluster that fails partway sets none of its switches */
+        for (auto const &argv : std::vector<std::vector<char const *>>{
+                 {"-xq"}, {"-fx=8"}, {"-vxu1", "2"}}) {
+            auto args = parse(argv);
+            REQUIRE(!args.ok);
+            REQUIRE(!args.present().any(flags));
+        }
+    }
+
+    SECTION("Batches and bound structs") {
+        char const *const line[] = {"program", "-vj12", "-x"};
+        std::pair<int, char const *const *> const lines[] = {{3, line}};
+        uint64_t present[1];
+        uint32_t offsets[8], counts[8];
+        bool ok[1];
+        decltype(parser)::parsed_batch batch{present, offsets, counts, ok, 1};
+        REQUIRE(parser.parse_batch(lines, batch) == 1);
+        auto args = parser.unpack(batch, 0, line);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["-j"] | 0) == 12);
+        REQUIRE(args.present().all(parser.mask({"-x", "-v", "-j"})));
+
+        struct options {
+            bool x = false, v = false;
+            int j = 0;
+        };
+        constexpr auto cli =
+            parser.bind(carp::field<&options::x>("-x"), carp::field<&options::v>("-v"),
+                        carp::field<&options::j>("-j"));
+        options o;
+        REQUIRE(cli.parse_into(3, line, o).ok);
+        REQUIRE((o.x && o.v && o.j == 12));
+    }
+}
+
+TEST_CASE("Repeatable switches", "[repeat]") {
+    static constexpr auto parser = carp::parser({
+        {"file", "a file"},
+        {"-I", "an include directory", 1, carp::repeatable},
+        {"-D", "a name and a value", 2, carp::repeatable},
+        {"-v", "more output", 0, carp::repeatable},
+        {"-o", "the output, not repeatable", 1},
+    });
+
+    char const *const argv[] = {"program", "-I", "a",  "-v", "-D",  "x", "1", "main.c",
+                                "-I",      "b",  "-vv", "-o", "c", "-Ic", "-o", "d"};
+    constexpr int argc = sizeof argv / sizeof argv[0];
+
+    SECTION("Occurrences in order") {
+        carp::occurrences<8> list;
+        auto args = parser.parse(argc, argv, list);
+        REQUIRE(args.ok);
+        REQUIRE(list.size() == 7);
+
+        std::vector<std::string_view> dirs;
+        for (auto dir : args.each<std::string_view>("-I"))
+            dirs.push_back(*dir);
+        REQUIRE(dirs == std::vector<std::string_view>{"a", "b", "c"});
+
+        auto defines = args.each<std::tuple<std::string_view, int>>(parser.id("-D"));
+        REQUIRE(std::distance(defines.begin(), defines.end()) == 1);
+        REQUIRE(**defines.begin() == std::tuple{"x"sv, 1});
+
+        /* the last occurrence is the value, as for any other switch */
+        REQUIRE(*(args["-I"] | ""sv) == "c");
+        REQUIRE(*(args["-o"] | ""sv) == "d");
+        REQUIRE(*(args["file"] | ""sv) == "main.c");
+    }
+
+    SECTION("Counts") {
+        auto args = parser.parse(argc, argv);
+        REQUIRE(args.ok);
+        REQUIRE(args.count("-v") == 3);
+        REQUIRE(args.count("-I") == 3);
+        REQUIRE(args.count(parser.id("-o")) == 2);
+        REQUIRE(args.count("file") == 1);
+        REQUIRE(args.count("-D") == 1);
+        REQUIRE(args.count("-z") == 0);
+
+        /* without storage there are no occurrences to visit */
+        auto dirs = args.each<std::string_view>("-I");
+        REQUIRE(dirs.begin() == dirs.end());
+    }
+
+    SECTION("Conversions and failures") {
+        std::string_view const words[] = {"program", "-I", "1", "-I", "x", "-I", "3"};
+        carp::occurrences<3> list;
+        auto args = parser.parse(7, words, list);
+        REQUIRE(args.ok);
+        std::vector<std::optional<int>> values(args.each<int>("-I").begin(),
+                                               args.each<int>("-I").end());
+        REQUIRE(values == std::vector<std::optional<int>>{1, std::nullopt, 3});
+
+        carp::occurrences<2> small;
+        REQUIRE(!parser.parse(7, words, small).ok);
+        REQUIRE(small.size() == 2);
+    }
+}
+
+TEST_CASE("End of options and tails", "[rest]") {
+    static constexpr auto launcher = carp::parser({
+        {"-n", "number of workers", 1},
+        {"-v", "verbose"},
+        {"command...", "the command to run, and its arguments"},
+    });
+    static constexpr auto rm = carp::parser({
+        {"file", "the file to remove"},
+        {"-f", "force"},
+    });
+
+    SECTION("Tails are views of argv") {
+        char const *const with_marker[] = {"launcher", "-n", "4",      "--",
+                                           "./worker", "-v", "--flags", nullptr};
+        char const *const without[] = {"launcher", "-n", "4", "./worker", "-v", "--flags",
+                                       nullptr};
+        for (auto [argc, argv] : {std::pair{7, with_marker}, std::pair{6, without}}) {
+            auto args = launcher.parse(argc, argv);
+            REQUIRE(args.ok);
+            REQUIRE(*(args["-n"] | 0) == 4);
+            REQUIRE(!args["-v"]);
+            REQUIRE(args["command..."]);
+
+            auto const rest = args.rest();
+            REQUIRE(rest.argc == 3);
+            REQUIRE(rest.argv == argv + argc - 3);
+            REQUIRE(rest.argv[rest.argc] == nullptr);
+            REQUIRE(rest.views == nullptr);
+            REQUIRE(std::string_view(rest.argv[2]) == "--flags");
+        }
+    }
+
+    SECTION("Tails need no parser") {
+        auto const parse = [](char const *const *argv) {
+            auto const local = launcher;
+            return local.parse(3, argv);
+        };
+        char const *const argv[] = {"launcher", "./worker", "-v", nullptr};
+        auto const rest = parse(argv).rest();
+        REQUIRE(rest.argc == 2);
+        REQUIRE(rest.argv == argv + 1);
+    }
+
+    SECTION("No tail") {
+        char const *const argv[] = {"launcher", "-v", "--"};
+        auto args = launcher.parse(3, argv);
+        REQUIRE(args.ok);
+        REQUIRE(args["-v"]);
+        REQUIRE(!args["command..."]);
+        REQUIRE(args.rest().argc == 0);
+        REQUIRE(args.rest().argv == nullptr);
+
+        REQUIRE(rm.parse(1, argv).rest().argc == 0);
+    }
+
+    SECTION("Only positionals after --") {
+        char const *const argv[] = {"rm", "-f", "--", "-f"};
+        auto args = rm.parse(4, argv);
+        REQUIRE(args.ok);
+        REQUIRE(args["-f"]);
+        REQUIRE(*(args["file"] | ""sv) == "-f");
+
+        char const *const extra[] = {"rm", "--", "a", "b"};
+        REQUIRE(!rm.parse(4, extra).ok);
+        char const *const twice[] = {"rm", "--", "--"};
+        REQUIRE(*(rm.parse(3, twice)["file"] | ""sv) == "--");
+    }
+
+    SECTION("Split command lines and batches") {
+        carp::token_buffer<16> tokens;
+        auto args = launcher.parse("launcher -n 2 -- sh -c 'echo hi'", tokens);
+        REQUIRE(args.ok);
+        auto const rest = args.rest();
+        REQUIRE(rest.argc == 3);
+        REQUIRE(rest.views[2] == "echo hi");
+
+        char const *const line[] = {"launcher", "-v", "env", "-i"};
+        std::pair<int, char const *const *> const lines[] = {{4, line}};
+        uint64_t present[1];
+        uint32_t offsets[3], counts[3];
+        bool ok[1];
+        decltype(launcher)::parsed_batch batch{present, offsets, counts, ok, 1};
+        REQUIRE(launcher.parse_batch(lines, batch) == 1);
+        auto unpacked = launcher.unpack(batch, 0, line);
+        REQUIRE(unpacked.ok);
+        REQUIRE(unpacked.rest().argc == 2);
+        REQUIRE(unpacked.rest().argv == line + 2);
+    }
+}
+
+TEST_CASE("Values after =", "[assigned]") {
+    static constexpr auto parser = carp::parser({
+        {"--threads", "number of threads", 1},
+        {"--name", "a name", 1},
+        {"--define", "a definition", 1, carp::repeatable},
+        {"--pair", "two integers", 2},
+        {"--force", "a boolean switch"},
+        {"-j", "jobs", 1},
+    });
+
+    SECTION("Values are views of the word") {
+        char const *const argv[] = {"program", "--threads=8", "--name=a=b", "-j=3"};
+        auto args = parser.parse(4, argv);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--threads"] | 0) == 8);
+        REQUIRE(*(args["-j"] | 0) == 3);
+        auto const name = *(args["--name"] | carp::required<std::string_view>);
+        REQUIRE(name == "a=b");
+        REQUIRE(name.data() == argv[2] + 7);
+        REQUIRE(*(args["--name"] | carp::required<char const *>) == argv[2] + 7);
+    }
+
+    SECTION("Empty values") {
+        char const *const argv[] = {"program", "--name=", "--threads="};
+        auto args = parser.parse(3, argv);
+        REQUIRE(*(args["--name"] | carp::required<std::string_view>) == "");
+        REQUIRE(!(args["--threads"] | carp::required<int>));
+        REQUIRE(!args.ok);
+    }
+
+    SECTION("Split command lines, batches, occurrences and bound structs") {
+        carp::token_buffer<8> tokens;
+        carp::occurrences<4> list;
+        REQUIRE(tokens.split("program --define=a --threads=12 '--define=b c'"));
+        auto args = parser.parse(static_cast<int>(tokens.size()), tokens.data(), list);
+        REQUIRE(args.ok);
+        REQUIRE(*(args["--threads"] | 0) == 12);
+        std::vector<std::string_view> defines;
+        for (auto d : args.each<std::string_view>("--define"))
+            defines.push_back(*d);
+        REQUIRE(defines == std::vector<std::string_view>{"a", "b c"});
+
+        char const *const line[] = {"program", "--threads=16"};
+        std::pair<int, char const *const *> const lines[] = {{2, line}};
+        uint64_t present[1];
+        uint32_t offsets[6], counts[6];
+        bool ok[1];
+        decltype(parser)::parsed_batch batch{present, offsets, counts, ok, 1};
+        REQUIRE(parser.parse_batch(lines, batch) == 1);
+        REQUIRE(*(parser.unpack(batch, 0, line)["--threads"] | 0) == 16);
+
+        struct options {
+            int threads = 1;
+        } o;
+        constexpr auto cli = parser.bind(carp::field<&options::threads>("--threads"));
+        REQUIRE(cli.parse_into(2, line, o).ok);
+        REQUIRE(o.threads == 16);
+    }
+
+    SECTION("Failures") {
+        for (char const *word :
+             {"--force=1", "--pair=1", "--thread=8", "--=8", "--threads8"}) {
+            char const *const argv[] = {"program", word, "2"};
+            REQUIRE(!parser.parse(3, argv).ok);
+        }
+    }
+
+    SECTION("Values are not read past their end") {
+        std::string_view const text = "12345";
+        std::string_view const words[] = {text.substr(0, 2), text.substr(1, 3)};
+        REQUIRE(*carp::unwrapper<int>::get(1, words) == 12);
+        REQUIRE(*carp::unwrapper<int>::get(1, words + 1) == 234);
+        REQUIRE(*carp::unwrapper<double>::get(1, words + 1) == 234.0);
+        REQUIRE(*carp::unwrapper<long double>::get(1, words) == 12.0L);
+    }
+}
+
+TEST_CASE("Usage text", "[usage]") {
+    static constexpr auto parser = carp::parser({
+        {"input", "the file to read"},
+        {"rest...", "everything else"},
+        {"-v", "be verbose, with a description long enough to be wrapped over a "
+               "couple of lines\nand an explicit line break"},
+        {"--jobs", "how many jobs to run", 1},
+    });
+    static constexpr auto lone = carp::parser({{"-x", "a switch"}});
+
+    auto streamed = [](auto const &p, char const *name, unsigned cols) {
+        std::ostringstream os;
+        os << p.usage(name, cols);
+        return os.str();
+    };
+
+    SECTION("Buffers hold what streams print") {
+        for (unsigned cols : {50u, 80u, 120u}) {
+            auto const expected = streamed(parser, "/usr/bin/tool", cols);
+            char buf[1024];
+            auto const n = parser.usage_to(buf, sizeof buf, "/usr/bin/tool", cols);
+            REQUIRE(n == parser.usage_size("/usr/bin/tool", cols));
+            REQUIRE(std::string(buf, n) == expected);
+        }
+        auto const expected = streamed(lone, "tool", 80);
+        REQUIRE(expected == "Usage: tool [options]\n\nOptions:\n        -x   a switch");
+        char buf[64];
+        REQUIRE(std::string(buf, lone.usage_to(buf, sizeof buf, "tool")) == expected);
+    }
+
+    SECTION("Compile-time text") {
+        static constexpr auto text = parser.usage_text<parser.usage_size("tool")>("tool");
+        REQUIRE(std::string(text.data(), text.size()) == streamed(parser, "tool", 80));
+    }
+
+    SECTION("Short buffers get a prefix") {
+        auto const expected = streamed(parser, "tool", 80);
+        char buf[16];
+        std::memset(buf, '#', sizeof buf);
+        REQUIRE(parser.usage_to(buf, 10, "tool") == expected.size());
+        REQUIRE(std::string(buf, 10) == expected.substr(0, 10));
+        REQUIRE(buf[10] == '#');
+    }
+
+#if CARP_HAS_UNISTD
+    SECTION("Written to a file descriptor") {
+        std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(std::tmpfile(),
+                                                              std::fclose);
+        REQUIRE(file);
+        char buf[1024];
+        REQUIRE(parser.write_usage(fileno(file.get()), buf, sizeof buf, "tool"));
+        REQUIRE(!parser.write_usage(fileno(file.get()), buf, 8, "tool"));
+        auto const expected = streamed(parser, "tool", 80);
+        std::string read(expected.size() + 1, '\0');
+        std::rewind(file.get());
+        read.resize(std::fread(read.data(), 1, read.size(), file.get()));
+        REQUIRE(read == expected);
+    }
+#endif
+}
+
+TEST_CASE("Long command lines", "[long]") {
+    static constexpr auto parser = carp::parser({
+        {"first", "a positional"},
+        {"rest...", "everything after it"},
+        {"-v", "a boolean switch", 0, carp::repeatable},
+        {"-I", "a directory", 1, carp::repeatable},
+    });
+
+    /* switches on either side of each 64-word block, values included */
+    std::vector<std::string> words{"program"}, dirs;
+    size_t verbose = 0;
+    for (size_t i = 0; words.size() < 300; ++i) {
+        if (i % 3 == 0) {
+            words.push_back("-v");
+            ++verbose;
+        } else {
+            dirs.push_back("dir" + std::to_string(i));
+            words.push_back("-I");
+            words.push_back(dirs.back());
+        }
+    }
+    for (char const *w : {"file", "--", "-v", "-I", "x"})
+        words.push_back(w);
+
+    std::vector<char const *> argv;
+    std::vector<std::string_view> views;
+    for (auto &w : words) {
+        argv.push_back(w.c_str());
+        views.push_back(w);
+    }
+    auto const argc = static_cast<int>(words.size());
+
+    carp::occurrences<300> from_argv, from_views;
+    auto a = parser.parse(argc, argv.data(), from_argv);
+    auto b = parser.parse(argc, views.data(), from_views);
+    for (auto *args : {&a, &b}) {
+        REQUIRE(args->ok);
+        REQUIRE(args->count("-v") == verbose);
+        REQUIRE(args->count("-I") == dirs.size());
+        REQUIRE(*((*args)["first"] | ""sv) == "file");
+        REQUIRE(args->rest().argc == 3);
+
+        std::vector<std::string> seen;
+        for (auto dir : args->each<std::string_view>("-I"))
+            seen.emplace_back(*dir);
+        REQUIRE(seen == dirs);
+    }
+}
+
+TEST_CASE("Thousands of arguments", "[huge]") {
+    constexpr size_t n = 4096;
+    using huge_parser = carp::parser<n>;
+
+    /* "--s0000" to "--s4095", half of them taking a value, and "file" */
+    std::vector<std::string> names;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        auto digits = std::to_string(i);
+        names.push_back("--s" + std::string(4 - digits.size(), '0') + digits);
+    }
+    names.push_back("file");
+    struct table {
+        huge_parser::arg args[n];
+    };
+    auto const args = std::make_unique<table>();
+    for (size_t i = 0; i + 1 < n; ++i)
+        args->args[i] = {names[i], "a generated switch", i % 2};
+    args->args[n - 1] = {names[n - 1], "a positional"};
+
+    /* built at run time, where it used to take quadratic time */
+    auto const parser = std::make_unique<huge_parser>(args->args);
+    for (size_t i = 0; i + 1 < n; ++i)
+        REQUIRE(parser->id(names[i]).index == i + 1);
+    REQUIRE(parser->id("file").index == 0);
+    REQUIRE(parser->id("--s4096").index == n);
+
+    std::vector<char const *> argv{"program", "input"};
+    for (size_t i = 0; i + 1 < n; i += 7) {
+        argv.push_back(names[i].c_str());
+        if (i % 2)
+            argv.push_back("7");
+    }
+    auto parsed = parser->parse(static_cast<int>(argv.size()), argv.data());
+    REQUIRE(parsed.ok);
+    REQUIRE(*(parsed["file"] | ""sv) == "input");
+    for (size_t i = 0; i + 1 < n; ++i) {
+        REQUIRE(!!parsed[names[i]] == (i % 7 == 0));
+        if (i % 14 == 7)
+            REQUIRE(*(parsed[names[i]] | 0) == 7);
+    }
+
+    auto const name = [&](size_t j) { return std::string_view(names[j]); };
+    REQUIRE(carp::detail::all_distinct<n>(n, name));
+    names[n / 2] = names[n / 3];
+    REQUIRE(!carp::detail::all_distinct<n>(n, name));
+}
@@ -0,0 +1,41 @@
+#include <carp.h>
+
+/* Each CARP_TABLE but the first is a table that make_parser must reject at
+ * compile time, NDEBUG or not. CMake builds one target per table and expects
+ * the build to fail with the matching message; the first one must build. */
+
+#ifndef CARP_TABLE
+#define CARP_TABLE 0
+#endif
+
+constexpr carp::arg table[] = {
+#if CARP_TABLE == 0
+    {"file", "the input"},
+    {"rest...", "the other inputs"},
+    {"-v", "be verbose", 0, carp::repeatable},
+    {"--jobs", "how many jobs", 1, "JOBS"},
+#elif CARP_TABLE == 1
+    {"2nd", "a name starting with a digit"},
+#elif CARP_TABLE == 2
+    {"--", "the end of the options"},
+#elif CARP_TABLE == 3
+    {"-v", "be verbose"},
+    {"-v", "be very verbose"},
+#elif CARP_TABLE == 4
+    {"-n", "too many values", 0x10000},
+#elif CARP_TABLE == 5
+    {"file", "a repeated positional", 0, carp::repeatable},
+#elif CARP_TABLE == 6
+    {"rest...", "everything"},
+    {"file", "after the tail"},
+#elif CARP_TABLE == 7
+    {"--pair", "two values from one variable", 2, "PAIR"},
+#elif CARP_TABLE == 8
+    {"--a", "a", 1, "SAME"},
+    {"--b", "b", 1, "SAME"},
+#endif
+};
+
+constexpr auto parser = carp::make_parser<table>();
+
+int main() { return parser.id("-v").index == 0; }
@@ -0,0 +1,552 @@
+#include <carp.h>
+#include <catch.hpp>
+#include <cstring>
+#include <string>
+
+/* Everything here is checked at compile time: if this file builds, parse(),
+ * parsed_args and the unwrappers work in constant expressions. The single
+ * runtime test makes sure the constant-evaluated number parsing agrees with
+ * the runtime one. */
+
+using namespace std::literals::string_view_literals;
+
+namespace {
+
+template <typename T>
+constexpr std::optional<T> num(std::string_view s) {
+    return carp::detail::str_to_num<T>::get(s.data(), s.data() + s.size());
+}
+
+template <typename T>
+constexpr bool fails(std::string_view s) {
+    return !num<T>(s);
+}
+
+template <typename T>
+constexpr bool same(std::optional<T> x, T y) {
+    return x && (*x == y) && ((*x < 0) == (y < 0));
+}
+
+/* std::array's operator== is not constexpr before C++20. */
+template <typename T, size_t n>
+constexpr bool equal(std::array<T, n> const &x, std::array<T, n> const &y) {
+    for (size_t i = 0; i < n; ++i)
+        if (x[i] != y[i])
+            return false;
+    return true;
+}
+
+constexpr auto parser = carp::parser({
+    {"a", "'a', a required integer"},
+    {"b", "'b', a string"},
+    {"c", "'c', a double"},
+    {"-s", "'s', a boolean switch"},
+    {"-t", "'t', a switch taking a string as an extra argument", 1},
+    {"-u", "'u', a switch taking two integers as extra arguments", 2},
+    {"-w", "'w', a switch taking a string, an integer and a double", 3},
+});
+
+struct decoded {
+    bool ok;
+    int a;
+    std::string_view b;
+    double c;
+    bool s;
+    std::string_view t;
+    std::array<int, 2> u;
+    std::tuple<std::string_view, int, double> w;
+};
+
+template <size_t n>
+constexpr decoded decode(char const *const (&argv)[n]) {
+    auto args = parser.parse(n, argv);
+
+    auto a = args["a"] | carp::required<int>;
+    auto b = args["b"] | "zebra"sv;
+    auto c = args["c"] | 1.5;
+    auto t = args["-t"] | "none"sv;
+    auto u = args[parser.id("-u")] | std::array{0, 0};
+    auto w = args["-w"] | std::tuple{"gasket"sv, 4, 1.25};
+
+    return decoded{args.ok,
+                   a ? *a : -1,
+                   b ? *b : "",
+                   c ? *c : -1,
+                   args["-s"],
+                   t ? *t : "",
+                   u ? *u : std::array{-1, -1},
+                   w ? *w : std::tuple{""sv, -1, -1.0}};
+}
+
+constexpr char const *full[] = {"program", "10", "-t", "cartwheel", "zaga", "-s", "-u",
+                                "1", "2", "-w", "cog", "7", "0.25", "3.5"};
+constexpr auto full_d = decode(full);
+static_assert(full_d.ok);
+static_assert(full_d.a == 10 && full_d.b == "zaga" && full_d.c == 3.5);
+static_assert(full_d.s && full_d.t == "cartwheel" && equal(full_d.u, std::array{1, 2}));
+static_assert(full_d.w == std::tuple{"cog"sv, 7, 0.25});
+
+constexpr char const *defaults[] = {"program", "-1"};
+constexpr auto defaults_d = decode(defaults);
+static_assert(defaults_d.ok);
+static_assert(defaults_d.a == -1 && defaults_d.b == "zebra" && defaults_d.c == 1.5);
+static_assert(!defaults_d.s && defaults_d.t == "none");
+static_assert(equal(defaults_d.u, std::array{0, 0}));
+static_assert(defaults_d.w == std::tuple{"gasket"sv, 4, 1.25});
+
+constexpr char const *missing_required[] = {"program", "-s"};
+static_assert(!decode(missing_required).ok);
+
+constexpr char const *unknown_switch[] = {"program", "1", "-x"};
+static_assert(!decode(unknown_switch).ok);
+
+constexpr char const *too_many[] = {"program", "1", "b", "2.5", "extra"};
+static_assert(!decode(too_many).ok);
+
+constexpr char const *bad_value[] = {"program", "1", "-u", "1", "two"};
+static_assert(!decode(bad_value).ok && equal(decode(bad_value).u, std::array{-1, -1}));
+
+constexpr char const *short_switch[] = {"program", "1", "-u", "1"};
+static_assert(!decode(short_switch).ok);
+
+/* batches: a full line and a failing one, decoded back through unpack */
+constexpr auto batch_t = [] {
+    using line = std::pair<int, char const *const *>;
+    line const lines[] = {{14, full}, {3, unknown_switch}};
+    uint64_t present[2] = {};
+    uint32_t offsets[14] = {}, counts[14] = {};
+    bool ok[2] = {};
+    decltype(parser)::parsed_batch batch{present, offsets, counts, ok, 2};
+
+    auto const rows = parser.parse_batch(lines, batch);
+    auto args = parser.unpack(batch, 0, full);
+    auto const t = args["-t"] | carp::required<std::string_view>;
+    return std::tuple{rows, ok[0], ok[1], t ? *t : ""sv};
+}();
+static_assert(batch_t == std::tuple{size_t{2}, true, false, "cartwheel"sv});
+
+/* command line strings, split at compile time (the words stay in the buffer) */
+constexpr bool cmdline_ok = [] {
+    carp::token_buffer<16, 16> tokens;
+    auto args = parser.parse(R"(program 10 -t 'cart wheel' "za"\ ga -u 1 2 -s)", tokens);
+    auto const a = args["a"] | carp::required<int>;
+    auto const b = args["b"] | carp::required<std::string_view>;
+    auto const t = args["-t"] | carp::required<std::string_view>;
+    auto const u = args["-u"] | carp::required<std::array<int, 2>>;
+    return args.ok && *a == 10 && *b == "za ga" && *t == "cart wheel" && (*u)[1] == 2 &&
+           args["-s"];
+}();
+static_assert(cmdline_ok);
+
+/* parsed_args holds a few bytes per argument, the names staying in the parser */
+static_assert(sizeof(carp::parser<500>::parsed_args) <= 12 * 500 + 128);
+
+/* clustered short switches */
+constexpr auto cluster_parser = carp::parser({
+    {"-x", "'x', a boolean switch"},
+    {"-v", "'v', a boolean switch"},
+    {"-j", "'j', a switch taking an integer", 1},
+});
+constexpr char const *cluster_argv[] = {"program", "-vxj8"};
+constexpr bool cluster_ok = [] {
+    auto args = cluster_parser.parse(2, cluster_argv);
+    return args.ok && *(args["-j"] | 0) == 8 &&
+           args.present().all(cluster_parser.mask({"-x", "-v"}));
+}();
+static_assert(cluster_ok);
+
+/* repeatable switches */
+constexpr auto repeat_parser = carp::parser({
+    {"-I", "an include directory", 1, carp::repeatable},
+    {"-v", "more output", 0, carp::repeatable},
+});
+constexpr char const *repeat_argv[] = {"program", "-I", "a", "-vv", "-Ib", "-v"};
+constexpr bool repeat_ok = [] {
+    carp::occurrences<5> list;
+    auto args = repeat_parser.parse(6, repeat_argv, list);
+    std::string_view dirs[2];
+    size_t n = 0;
+    for (auto dir : args.each<std::string_view>("-I"))
+        dirs[n++] = *dir;
+    return args.ok && args.count("-v") == 3 && n == 2 && dirs[0] == "a" && dirs[1] == "b";
+}();
+static_assert(repeat_ok);
+
+/* end of options and tails */
+constexpr auto launcher = carp::parser({
+    {"-n", "number of workers", 1},
+    {"command...", "the command to run"},
+});
+constexpr char const *launch_argv[] = {"launcher", "-n", "4", "--", "sh", "-n"};
+constexpr bool rest_ok = [] {
+    auto args = launcher.parse(6, launch_argv);
+    auto const rest = args.rest();
+    return args.ok && *(args["-n"] | 0) == 4 && rest.argc == 2 &&
+           rest.argv == launch_argv + 4;
+}();
+static_assert(rest_ok);
+
+/* values after = */
+constexpr char const *assigned_argv[] = {"launcher", "-n=4", "sh"};
+constexpr bool assigned_ok = [] {
+    auto args = launcher.parse(3, assigned_argv);
+    return args.ok && *(args["-n"] | 0) == 4 && args.rest().argc == 1;
+}();
+static_assert(assigned_ok);
+
+/* usage text */
+constexpr auto help_parser = carp::parser({
+    {"file", "input"},
+    {"-v", "verbose"},
+});
+constexpr auto help =
+    help_parser.usage_text<help_parser.usage_size("bin/tool")>("bin/tool");
+constexpr std::string_view help_expected = "Usage: tool [options] file\n\n"
+                                           "Arguments:\n        file   input\n\n"
+                                           "Options:\n        -v     verbose";
+static_assert(std::string_view(help.data(), help.size()) == help_expected);
+
+/* environment variables */
+constexpr auto env_parser = carp::parser({
+    {"a", "'a', an integer", 0, "A"},
+    {"-s", "'s', a boolean switch", 0, "S"},
+    {"-t", "'t', a switch taking a string", 1, "T"},
+});
+constexpr char const *env_argv[] = {"program", "-t", "argv"};
+constexpr char const *envp[] = {"T=env", "B=2", "A=12", "S=", nullptr};
+constexpr bool env_ok = [] {
+    auto args = env_parser.parse(3, env_argv, envp);
+    auto const a = args["a"] | carp::required<int>;
+    auto const t = args["-t"] | carp::required<std::string_view>;
+    return args.ok && *a == 12 && *t == "argv" && args["-s"];
+}();
+static_assert(env_ok);
+
+/* binding to a struct */
+struct options {
+    int a = 0;
+    std::string_view b;
+    bool s = false;
+    std::array<int, 2> u{};
+};
+constexpr auto cli =
+    parser.bind(carp::field<&options::a>("a"), carp::field<&options::b>("b"),
+                carp::field<&options::s>("-s"), carp::field<&options::u>("-u"));
+constexpr bool bind_ok = [] {
+    char const *const argv[] = {"program", "10", "-s", "za", "-u", "1", "2"};
+    options o;
+    auto const res = cli.parse_into(7, argv, o);
+    return res.ok && o.a == 10 && o.b == "za" && o.s && o.u[1] == 2;
+}();
+static_assert(bind_ok);
+
+/* subcommands */
+constexpr auto tool = carp::commands(carp::command("add", parser),
+                                     carp::command("env", env_parser));
+constexpr char const *tool_argv[] = {"tool", "env", "3"};
+static_assert(*tool.parse(3, tool_argv, [](auto command, auto &args) {
+    return command == tool.index("env") && *(args["a"] | 0) == 3;
+}));
+static_assert(!tool.parse(2, env_argv, [](auto, auto &) { return 0; }));
+
+/* thousands of switches, "--aaaaa", "--aaaab" and on, every other taking a value */
+template <size_t N>
+struct many_switches {
+    char text[N * 8] = {};
+    typename carp::parser<N>::arg args[N];
+
+    constexpr many_switches() {
+        for (size_t i = 0; i < N; ++i) {
+            auto *p = text + i * 8;
+            p[0] = p[1] = '-';
+            for (size_t d = 7, v = i; d-- > 2; v /= 10)
+                p[d] = static_cast<char>('a' + v % 10);
+            args[i] = {std::string_view(p, 7), "a generated switch", i % 2};
+        }
+    }
+};
+constexpr many_switches<2048> huge_table{};
+constexpr auto huge = carp::parser<2048>(huge_table.args);
+static_assert(huge.id("--aaaaa").index == 0 && huge.id("--acaeh").index == 2047);
+constexpr char const *huge_argv[] = {"program", "--abcde", "--aaaab", "12"};
+constexpr bool huge_ok = [] {
+    auto args = huge.parse(4, huge_argv);
+    return args.ok && args["--abcde"] && *(args["--aaaab"] | 0) == 12 && !args["--aaaaa"];
+}();
+static_assert(huge_ok);
+constexpr auto huge_name = [](size_t j) { return huge_table.args[j].name; };
+static_assert(carp::detail::all_distinct<2048>(2048, huge_name));
+constexpr auto repeated_name = [](size_t j) { return "ab"sv.substr(j / 2); };
+static_assert(!carp::detail::all_distinct<3>(3, repeated_name));
+
+/* tables checked at compile time */
+constexpr carp::arg checked_table[] = {
+    {"file", "the input"},
+    {"-v", "be verbose", 0, carp::repeatable},
+    {"--jobs", "how many jobs", 1, "JOBS"},
+};
+constexpr auto checked = carp::make_parser<checked_table>();
+static_assert(checked.id("--jobs").index == 2);
+
+template <size_t N>
+constexpr carp::table_error check(carp::arg const (&arguments)[N]) {
+    return carp::parser<N>::validate(arguments);
+}
+using carp::table_error;
+static_assert(check(checked_table) == table_error::none);
+static_assert(check({{"file", ""}, {"9lives", ""}}) == table_error::invalid_name);
+static_assert(check({{"two words", ""}}) == table_error::invalid_name);
+static_assert(check({{"--", ""}}) == table_error::ambiguous_name);
+static_assert(check({{"-", ""}}) == table_error::ambiguous_name);
+static_assert(check({{"-5", ""}}) == table_error::ambiguous_name);
+static_assert(check({{"--a=b", ""}}) == table_error::ambiguous_name);
+static_assert(check({{"-v", ""}, {"file", ""}, {"-v", ""}}) == table_error::repeated_name);
+static_assert(check({{"-v", "", 0xffff}}) == table_error::too_many_values);
+static_assert(check({{"-v", "", 0xfffe}}) == table_error::none);
+static_assert(check({{"file", "", 0, carp::repeatable}}) ==
+              table_error::repeated_positional);
+static_assert(check({{"rest...", ""}, {"file", ""}}) == table_error::misplaced_tail);
+static_assert(check({{"rest...", ""}, {"-v", ""}}) == table_error::none);
+static_assert(check({{"-a", "", 1, "A=1"}}) == table_error::bad_env);
+static_assert(check({{"-a", "", 2, "A"}}) == table_error::bad_env);
+static_assert(check({{"a", "", 1, "A"}}) == table_error::bad_env);
+static_assert(check({{"-a", "", 1, "A"}, {"-b", "", 0, "A"}}) == table_error::repeated_env);
+
+/* unwrappers on their own */
+constexpr char const *words[] = {"12", "-3", "abc", "2.5"};
+static_assert(*carp::unwrapper<int>::get(1, words) == 12);
+static_assert(*carp::unwrapper<std::string_view>::get(1, words + 2) == "abc");
+static_assert(
+    equal(*carp::unwrapper<std::array<int, 2>>::get(2, words), std::array{12, -3}));
+static_assert(!carp::unwrapper<std::array<int, 2>>::get(3, words));
+static_assert(!carp::unwrapper<std::tuple<int, unsigned>>::get(2, words));
+static_assert(*carp::unwrapper<std::tuple<int, std::string_view, double>>::get(
+                  3, words + 1) == std::tuple{-3, "abc"sv, 2.5});
+
+/* integers */
+static_assert(same(num<int>("0"), 0) && same(num<int>("-0"), 0));
+static_assert(same(num<int>("42"), 42));
+static_assert(same(num<signed char>("127"), (signed char)127));
+static_assert(same(num<signed char>("-128"), (signed char)-128));
+static_assert(fails<signed char>("128") && fails<signed char>("-129"));
+static_assert(same(num<unsigned char>("255"), (unsigned char)255));
+static_assert(fails<unsigned char>("256") && fails<unsigned char>("-1"));
+static_assert(same(num<short>("-32768"), (short)-32768) && fails<short>("32768"));
+static_assert(same(num<unsigned short>("65535"), (unsigned short)65535));
+static_assert(same(num<int>("2147483647"), 2147483647) && fails<int>("2147483648"));
+static_assert(same(num<int>("-2147483648"), -2147483647 - 1));
+static_assert(fails<int>("-2147483649"));
+static_assert(same(num<int>("-123456789"), -123456789) && fails<int>("12345678x"));
+static_assert(same(num<unsigned>("012345678"), 12345678u));
+static_assert(same(num<long long>("-9223372036854775808"), -9223372036854775807ll - 1));
+static_assert(fails<long long>("9223372036854775808"));
+static_assert(same(num<unsigned long long>("18446744073709551615"),
+                   18446744073709551615ull));
+static_assert(fails<unsigned long long>("18446744073709551616"));
+static_assert(same(num<unsigned long long>("000000000000000000000000042"), 42ull));
+static_assert(fails<int>("") && fails<int>("-") && fails<int>("+1") && fails<int>(" 1"));
+static_assert(fails<int>("1 ") && fails<int>("1.") && fails<int>("1e3"));
+static_assert(same(num<int>("0x10"), 16) && same(num<int>("0XfF"), 255));
+static_assert(same(num<int>("0b101"), 5) && same(num<int>("0o17"), 15));
+static_assert(same(num<signed char>("-0x80"), (signed char)-128));
+static_assert(fails<signed char>("0x80"));
+static_assert(fails<int>("0x") && fails<int>("0b2") && fails<int>("0o8") && fails<int>("0xg"));
+static_assert(same(num<unsigned long long>("0xffffffffffffffff"), 18446744073709551615ull));
+static_assert(fails<unsigned long long>("0x10000000000000000"));
+static_assert(*num<bool>("1") && !*num<bool>("0") && fails<bool>("2"));
+
+/* floating point, compared with the compiler's own (correctly rounded) literals */
+static_assert(same(num<double>("0"), 0.) && same(num<double>("-0"), -0.));
+static_assert(same(num<double>("0.1"), 0.1) && same(num<float>("0.1"), 0.1f));
+static_assert(same(num<double>(".5"), .5) && same(num<double>("5."), 5.));
+static_assert(same(num<double>("1e10"), 1e10) && same(num<double>("1E-10"), 1e-10));
+static_assert(same(num<double>("-123.456e+7"), -123.456e+7));
+static_assert(same(num<double>("3.141592653589793238462643383279"),
+                   3.141592653589793238462643383279));
+static_assert(same(num<double>("1.7976931348623157e308"), 1.7976931348623157e308));
+static_assert(fails<double>("1.7976931348623159e308") && fails<double>("1e309"));
+static_assert(same(num<double>("2.2250738585072011e-308"), 2.2250738585072011e-308));
+static_assert(same(num<double>("2.2250738585072014e-308"), 2.2250738585072014e-308));
+static_assert(same(num<double>("4.9406564584124654e-324"), 4.9406564584124654e-324));
+static_assert(same(num<double>("2.4703282292062328e-324"), 4.9406564584124654e-324));
+static_assert(fails<double>("2.4703282292062327e-324") && fails<double>("1e-400"));
+static_assert(same(num<double>("9007199254740993"), 9007199254740992.));
+static_assert(same(num<double>("9007199254740993.0000000000000000000000000000001"),
+                   9007199254740994.));
+static_assert(same(num<double>("9007199254740995"), 9007199254740996.));
+static_assert(same(num<double>("0.00000000000000000000000000000000000000001e41"), 1.));
+static_assert(same(num<float>("3.4028235e38"), 3.4028235e38f) && fails<float>("3.5e38"));
+static_assert(same(num<float>("1.17549435e-38"), 1.17549435e-38f));
+static_assert(same(num<float>("1.4e-45"), 1.4e-45f) && fails<float>("1e-46"));
+static_assert(same(num<float>("16777217"), 16777216.f));
+static_assert(same(num<float>("16777219"), 16777220.f));
+
+/* the precomputed powers of five: exact below 5^28, and fast_float's first entry */
+constexpr bool exact_powers_of_five = [] {
+    using carp::detail::powers_of_five;
+    uint64_t p = 1;
+    for (int q = 0; q < 28; ++q, p *= 5) {
+        auto const i = 2 * (q - powers_of_five::smallest);
+        auto const high = p << carp::detail::count_leading_zeros(p);
+        if (powers_of_five::table[i] != high || powers_of_five::table[i + 1] != 0)
+            return false;
+    }
+    return powers_of_five::table[0] == 0xeef453d6923bd65a &&
+           powers_of_five::table[1] == 0x113faa2906a13b3f;
+}();
+static_assert(exact_powers_of_five);
+static_assert(std::numeric_limits<long double>::digits > 64 ||
+              std::numeric_limits<long double>::max_exponent10 < 4000 ||
+              (same(num<long double>("0.1"), 0.1l) &&
+               same(num<long double>("1e4000"), 1e4000l)));
+static_assert(num<double>("inf") == std::numeric_limits<double>::infinity());
+static_assert(num<double>("-Infinity") == -std::numeric_limits<double>::infinity());
+static_assert(*num<double>("nan") != *num<double>("nan") && num<float>("NaN(x_1)"));
+static_assert(fails<double>("") && fails<double>(".") && fails<double>("-"));
+static_assert(fails<double>("+1"));
+static_assert(fails<double>("1e") && fails<double>("1e+") && fails<double>("e5"));
+static_assert(fails<double>("0x1p3") && fails<double>("1.2.3"));
+static_assert(fails<double>("infinit") && fails<double>("nan("));
+static_assert(fails<double>("nan(a b)"));
+static_assert(fails<double>("1.0 "));
+
+constexpr std::string_view real_inputs[] = {
+    "0",
+    "-0.0",
+    "1",
+    "0.1",
+    "0.3",
+    "2.5e-3",
+    "123456789012345678901234567890",
+    "1.00000000000000011102230246251565404236316680908203125",
+    "1.00000000000000011102230246251565404236316680908203124",
+    "1.00000000000000011102230246251565404236316680908203126",
+    "7.2057594037927933e16",
+    "8.988465674311580536566680e307",
+    "1.7976931348623157e308",
+    "4.9406564584124654e-324",
+    "2.225073858507201e-308",
+    "3.4028234663852886e38",
+    "1.1754943508222875e-38",
+    "1.4012984643248171e-45",
+    "6.103515625e-05",
+    "0.000000000000000000000000000000000000000000000000000000000000000000123",
+    "1e23",
+    "8.589973e9",
+    "1.00000005960464477550",
+    "1.0000000596046447755e-1",
+    "33554431",
+    "33554433",
+};
+constexpr size_t n_real_inputs = std::size(real_inputs);
+
+template <typename T>
+struct decoded_all {
+    std::array<T, n_real_inputs> values{};
+    std::array<bool, n_real_inputs> ok{};
+};
+
+template <typename T>
+constexpr auto decode_all() {
+    decoded_all<T> d;
+    for (size_t i = 0; i < n_real_inputs; ++i) {
+        auto const x = num<T>(real_inputs[i]);
+        d.ok[i] = !!x;
+        d.values[i] = x ? *x : T{};
+    }
+    return d;
+}
+} // namespace
+
+/* enums by name */
+enum class mode { fast, safe, audit };
+
+namespace carp {
+template <>
+struct enum_names<mode> {
+    static constexpr std::pair<std::string_view, mode> values[] = {
+        {"fast", mode::fast}, {"safe", mode::safe}, {"audit", mode::audit}};
+};
+} // namespace carp
+
+constexpr char const *modes[] = {"audit", "fast", "Fast", ""};
+constexpr char const *words_by_mode[] = {"safe", "3"};
+static_assert(*carp::unwrapper<mode>::get(1, modes) == mode::audit);
+static_assert(*carp::unwrapper<mode>::get(1, modes + 1) == mode::fast);
+static_assert(!carp::unwrapper<mode>::get(1, modes + 2));
+static_assert(!carp::unwrapper<mode>::get(1, modes + 3));
+static_assert(!carp::unwrapper<mode>::get(2, modes));
+static_assert(carp::detail::enum_lookup<mode>.perfect);
+static_assert(*carp::unwrapper<std::tuple<mode, int>>::get(2, words_by_mode) ==
+              std::tuple{mode::safe, 3});
+
+constexpr mode mode_of(std::string_view word) {
+    constexpr auto parser = carp::parser({{"--mode", "how to run", 1}});
+    char const *const argv[] = {"program", word.data()};
+    auto args = parser.parse(word.empty() ? 1 : 2, argv);
+    return *(args["--mode"] | mode::safe);
+}
+static_assert(mode_of("--mode=audit") == mode::audit);
+static_assert(mode_of("") == mode::safe);
+
+/* sizes and durations */
+template <typename T>
+constexpr std::optional<T> unit(char const *word) {
+    return carp::unwrapper<T>::get(1, &word);
+}
+static_assert(unit<carp::byte_size>("4GiB")->bytes == 4ull << 30);
+static_assert(unit<carp::byte_size>("100MB")->bytes == 100000000);
+static_assert(unit<carp::byte_size>("16")->bytes == 16);
+static_assert(unit<carp::byte_size>("16EiB") == std::nullopt);
+static_assert(unit<carp::byte_size>("16777215TiB")->bytes == 16777215ull << 40);
+static_assert(unit<carp::byte_size>("16777216TiB") == std::nullopt);
+static_assert(unit<std::chrono::milliseconds>("250ms")->count() == 250);
+static_assert(unit<std::chrono::milliseconds>("2h")->count() == 7200000);
+static_assert(unit<std::chrono::milliseconds>("2000us")->count() == 2);
+static_assert(unit<std::chrono::milliseconds>("2001us") == std::nullopt);
+static_assert(unit<std::chrono::duration<double>>("1500us")->count() == 0.0015);
+static_assert(unit<std::chrono::seconds>("90") == std::nullopt);
+
+/* delimited lists */
+template <size_t K>
+constexpr bool listed(std::optional<carp::list<int, K>> const &l,
+                      std::initializer_list<int> values) {
+    if (!l || l->size != values.size())
+        return false;
+    size_t i = 0;
+    for (int v : values)
+        if ((*l)[i++] != v)
+            return false;
+    return true;
+}
+static_assert(listed(unit<carp::list<int, 8>>("1,2,3"), {1, 2, 3}));
+static_assert(listed(unit<carp::list<int, 8>>("0-3,-2--1,7"), {0, 1, 2, 3, -2, -1, 7}));
+static_assert(listed(unit<carp::list<int, 8>>(""), {}));
+static_assert(!unit<carp::list<int, 8>>("0-8"));
+static_assert(!unit<carp::list<int, 8>>("1,,2"));
+static_assert(!unit<carp::list<int, 8>>("3-1"));
+static_assert(unit<carp::list<mode, 2, '|'>>("audit|fast")->values[1] == mode::fast);
+
+TEST_CASE("Constant-evaluated and runtime number parsing agree", "[constexpr]") {
+    auto check = [](auto const &compile_time) {
+        using T = typename std::decay_t<decltype(compile_time.values)>::value_type;
+        for (size_t i = 0; i < n_real_inputs; ++i) {
+            auto const s = std::string(real_inputs[i]);
+            auto const runtime =
+                carp::detail::str_to_num<T>::get(s.data(), s.data() + s.size());
+            INFO(s);
+            REQUIRE(!!runtime == compile_time.ok[i]);
+            if (runtime)
+                REQUIRE(std::memcmp(&*runtime, &compile_time.values[i], sizeof(T)) == 0);
+        }
+    };
+
+    SECTION("floats") {
+        constexpr auto compile_time = decode_all<float>();
+        check(compile_time);
+    }
+    SECTION("doubles") {
+        constexpr auto compile_time = decode_all<double>();
+        check(compile_time);
+    }
+}